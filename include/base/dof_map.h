@@ -23,6 +23,7 @@
 // Local Includes
 #include "libmesh/libmesh_common.h"
 #include "libmesh/auto_ptr.h"
+#include "libmesh/enum_dof_reordering_type.h"
 #include "libmesh/enum_order.h"
 #include "libmesh/reference_counted_object.h"
 #include "libmesh/libmesh.h" // libMesh::invalid_uint
@@ -54,6 +55,7 @@ class DirichletBoundaries;
 class DofMap;
 class DofObject;
 class Elem;
+class ElementColoring;
 class FEType;
 class MeshBase;
 class PeriodicBoundaryBase;
@@ -247,6 +249,20 @@ public:
    */
   void clear_sparsity();
 
+  /**
+   * \returns A coloring of the active local elements by the dofs
+   * they touch once constraints are applied (see ElementColoring),
+   * computing it first if necessary.  The coloring is cached until
+   * dofs are next distributed or constraints next change, and should
+   * not first be requested from within threaded code.
+   */
+  const ElementColoring & active_local_element_coloring () const;
+
+  /**
+   * Releases the current element coloring, if any.
+   */
+  void clear_element_coloring ();
+
   /**
    * Adds a functor which can specify coupling requirements for
    * creation of sparse matrices.
@@ -685,6 +701,69 @@ public:
    */
   void set_implicit_neighbor_dofs(bool implicit_neighbor_dofs);
 
+  /**
+   * Chooses how \p distribute_dofs() reorders the degrees of freedom
+   * owned by each processor once they are distributed, to reduce the
+   * bandwidth (\p REVERSE_CUTHILL_MCKEE) or the factorization fill-in
+   * (\p NESTED_DISSECTION, which needs METIS) of the local block of
+   * the system matrix.  This overrides the --dof_reordering
+   * commandline option.
+   *
+   * Only the owned block is permuted, so the range of dofs on each
+   * processor is unchanged.  Since the new numbers are stored on the
+   * nodes and elements themselves, the send list, constraints,
+   * sparsity pattern and I/O all follow the new ordering.
+   */
+  void set_dof_reordering(DofReorderingType reordering)
+  { _dof_reordering = reordering; }
+
+  /**
+   * \returns The reordering that \p distribute_dofs() will use: the
+   * one set by \p set_dof_reordering() if any, otherwise the one
+   * given by the --dof_reordering commandline option, otherwise \p
+   * NO_REORDERING.
+   */
+  DofReorderingType dof_reordering() const;
+
+  /**
+   * Tells \p compute_sparsity() whether to patch the sparsity pattern
+   * it built for the previous distribution of dofs, rather than build
+   * a new one from scratch, after the mesh has been adaptively
+   * refined and coarsened.  This overrides the --incremental_sparsity
+   * commandline option.  It is off by default.
+   *
+   * Only the sparsity pattern is patched: \p distribute_dofs() still
+   * renumbers every dof and the constraints are still recomputed.
+   * When a large part of the mesh changes, or with higher order
+   * elements, patching can take longer than building from scratch.
+   *
+   * Only the rows of dofs near elements which were just refined or
+   * coarsened, or which have constrained dofs, are recomputed; the
+   * others are renumbered from the old pattern.  Rows kept this way
+   * may still hold a few couplings which the last refinement removed,
+   * so the pattern is a slight overestimate, but never an
+   * underestimate.  The full pattern of the previous step has to be
+   * kept until the next one, even if no attached matrix needs it.
+   *
+   * Systems with coupling functors besides the default one, implicit
+   * neighbor dofs, SCALAR variables, or an extra sparsity function or
+   * object always have their sparsity pattern built from scratch.
+   */
+  void set_incremental_sparsity(bool incremental_sparsity);
+
+  /**
+   * \returns Whether \p compute_sparsity() may patch the previous
+   * sparsity pattern; see \p set_incremental_sparsity().
+   */
+  bool incremental_sparsity() const;
+
+  /**
+   * \returns Whether the last \p compute_sparsity() patched the
+   * previous sparsity pattern, rather than building one from
+   * scratch; see \p set_incremental_sparsity().
+   */
+  bool sparsity_patched() const { return _sparsity_patched; }
+
   /**
    * Tells other library functions whether or not this problem
    * includes coupling between dofs in neighboring cells, as can
@@ -834,12 +913,14 @@ public:
   {
     libmesh_assert(_stashed_dof_constraints.empty());
     _dof_constraints.swap(_stashed_dof_constraints);
+    this->clear_element_coloring();
   }
 
   void unstash_dof_constraints()
   {
     libmesh_assert(_dof_constraints.empty());
     _dof_constraints.swap(_stashed_dof_constraints);
+    this->clear_element_coloring();
   }
 
 #ifdef LIBMESH_ENABLE_NODE_CONSTRAINTS
@@ -1266,9 +1347,26 @@ private:
                      ) const;
 
   /**
-   * Builds a sparsity pattern
+   * Builds a sparsity pattern, setting \p patched to whether it was
+   * patched from \p _old_sp
+   */
+  std::unique_ptr<SparsityPattern::Build> build_sparsity(const MeshBase & mesh,
+                                                         bool & patched) const;
+
+#ifdef LIBMESH_ENABLE_AMR
+  /**
+   * Fills in \p sp, which must be empty, by renumbering the rows of
+   * \p _old_sp and recomputing those near refined, coarsened or
+   * constrained elements, as described in \p
+   * set_incremental_sparsity().  Nonlocal rows are left in \p
+   * sp.nonlocal_pattern to be synchronized by the caller.
+   *
+   * \returns \p false, without touching \p sp, if the old pattern
+   * cannot be reused.
    */
-  std::unique_ptr<SparsityPattern::Build> build_sparsity(const MeshBase & mesh) const;
+  bool patch_sparsity(const MeshBase & mesh,
+                      SparsityPattern::Build & sp) const;
+#endif
 
   /**
    * Invalidates all active DofObject dofs for this system
@@ -1325,6 +1423,17 @@ private:
   void distribute_local_dofs_node_major (dof_id_type & next_free_dof,
                                          MeshBase & mesh);
 
+  /**
+   * Renumbers the degrees of freedom already distributed on this
+   * processor so that the nodes and elements holding them follow the
+   * given \p reordering of the graph which connects objects sharing
+   * an element.  The dofs of each object and variable group stay
+   * contiguous, and stay node- or variable-major as they were.
+   */
+  void reorder_local_dofs (MeshBase & mesh,
+                           DofReorderingType reordering,
+                           bool node_major_dofs);
+
   /*
    * A utility method for obtaining a set of elements to ghost along
    * with merged coupling matrices.
@@ -1534,6 +1643,31 @@ private:
    */
   std::unique_ptr<SparsityPattern::Build> _sp;
 
+  /**
+   * With incremental sparsity, the sparsity pattern built for the
+   * previous distribution of dofs, kept by \p clear_sparsity() until
+   * \p compute_sparsity() has patched it into the new one.
+   */
+  std::unique_ptr<SparsityPattern::Build> _old_sp;
+
+  /**
+   * The number of times \p distribute_dofs() has run, and its value
+   * when \p _sp (later \p _old_sp) was built, so that we only patch
+   * a pattern numbered like the old_dof_objects.
+   */
+  unsigned int _n_dof_distributions;
+  unsigned int _sp_dof_distribution;
+
+  /**
+   * Whether \p _sp was patched from \p _old_sp.
+   */
+  bool _sparsity_patched;
+
+  /**
+   * The cached coloring of active local elements by constrained dofs.
+   */
+  mutable std::unique_ptr<ElementColoring> _element_coloring;
+
   /**
    * The number of on-processor nonzeros in my portion of the
    * global matrix.  If need_full_sparsity_pattern is true, this will
@@ -1633,6 +1767,7 @@ private:
 #endif
 
   friend class SparsityPattern::Build;
+  friend class ElementColoring;
 
   /**
    * Bools to indicate if we override the --implicit_neighbor_dofs
@@ -1640,6 +1775,19 @@ private:
    */
   bool _implicit_neighbor_dofs_initialized;
   bool _implicit_neighbor_dofs;
+
+  /**
+   * The reordering set by \p set_dof_reordering(), or \p
+   * INVALID_REORDERING to use the commandline option.
+   */
+  DofReorderingType _dof_reordering;
+
+  /**
+   * Bools to indicate if we override the --incremental_sparsity
+   * commandline option.
+   */
+  bool _incremental_sparsity_initialized;
+  bool _incremental_sparsity;
 };
 
 
@@ -361,6 +361,23 @@ public:
    */
   void pack_indexing(std::back_insert_iterator<std::vector<largest_id_type>> target) const;
 
+  /**
+   * \returns The number of entries in our DoF index buffer, which is
+   * the room needed to hold our indexing in a shared arena.
+   */
+  unsigned int index_buffer_size () const
+  { return _idx_buf_size; }
+
+  /**
+   * Copies our DoF indexing into \p arena, which must have room for
+   * index_buffer_size() entries, and uses it there from now on in
+   * place of separately allocated storage.  The arena must outlive
+   * this object, or at least its next change of indexing layout: any
+   * later change to the number of systems, variable groups or
+   * variables moves the indexing back into storage of our own.
+   */
+  void use_index_arena (dof_id_type * arena);
+
   /**
    * Print our buffer for debugging.
    */
@@ -441,7 +458,7 @@ private:
    *
    * where 'end_s' is the index past the end of the variable group storage for system \p s.
    *
-   * \note We specifically do not store the end for the last system - this always _idx_buf.size().
+   * \note We specifically do not store the end for the last system - this always _idx_buf_size.
    *
    * Specifically, consider the case of 4 systems, with 3, 0, 1, 2 variable groups, respectively.  The _idx_buf then looks like:
    *
@@ -453,7 +470,7 @@ private:
    * The ending index is then given by:
    *
    * \verbatim
-   * end_s = _idx_buf.size(), s == (ns-1),
+   * end_s = _idx_buf_size,   s == (ns-1),
    *       = _idx_buf[s+1]    otherwise.
    * \endverbatim
    *
@@ -479,10 +496,25 @@ private:
    * *within the system*. So for a system with 2 variable groups, 4 and 8 variables each,
    * the 5th variable in the system is the 1st variable in 2nd variable group.
    * (Now of course 0-base everything...  but you get the idea.)
+   *
+   * The buffer is normally allocated separately for each object, but
+   * MeshBase::compact_dof_indexing() may move it into a contiguous
+   * arena shared by the whole mesh, in which case we do not own it.
    */
   typedef dof_id_type index_t;
   typedef std::vector<index_t> index_buffer_t;
-  index_buffer_t _idx_buf;
+  index_t * _idx_buf;
+
+  /**
+   * The number of entries in \p _idx_buf.
+   */
+  unsigned int _idx_buf_size;
+
+  /**
+   * Whether \p _idx_buf points into a shared arena rather than to
+   * storage we own.
+   */
+  bool _idx_buf_in_arena;
 
   /**
    * Above we introduced the chimera ncv, which is a hybrid of the form
@@ -506,11 +538,24 @@ private:
    */
   unsigned int end_idx(const unsigned int s) const;
 
+  /**
+   * Replaces the entries [begin, end) of our index buffer with
+   * [new_begin, new_end), reallocating the buffer to fit exactly.
+   * This also moves the buffer out of any shared arena.
+   */
+  void splice_indices (const unsigned int begin,
+                       const unsigned int end,
+                       const index_t * new_begin,
+                       const index_t * new_end);
+
   // methods only available for unit testing
 #ifdef LIBMESH_IS_UNIT_TESTING
 public:
   void set_buffer (const std::vector<dof_id_type> & buf)
-  { _idx_buf = buf; }
+  {
+    this->clear_dofs();
+    this->splice_indices(0, 0, buf.data(), buf.data() + buf.size());
+  }
 #endif
 };
 
@@ -527,7 +572,10 @@ DofObject::DofObject () :
   _unique_id (invalid_unique_id),
 #endif
   _id (invalid_id),
-  _processor_id (invalid_processor_id)
+  _processor_id (invalid_processor_id),
+  _idx_buf (libmesh_nullptr),
+  _idx_buf_size (0),
+  _idx_buf_in_arena (false)
 {
   this->invalidate();
 }
@@ -597,11 +645,15 @@ void DofObject::invalidate ()
 inline
 void DofObject::clear_dofs ()
 {
-  // vector swap trick to force deallocation
-  index_buffer_t().swap(_idx_buf);
+  // Memory in a shared arena belongs to the mesh
+  if (!_idx_buf_in_arena)
+    delete [] _idx_buf;
+
+  _idx_buf = libmesh_nullptr;
+  _idx_buf_size = 0;
+  _idx_buf_in_arena = false;
 
   libmesh_assert_equal_to (this->n_systems(), 0);
-  libmesh_assert (_idx_buf.empty());
 }
 
 
@@ -725,8 +777,8 @@ bool DofObject::valid_processor_id () const
 inline
 unsigned int DofObject::n_systems () const
 {
-  return _idx_buf.empty() ?
-    0 : cast_int<unsigned int>(_idx_buf[0]);
+  return _idx_buf_size ?
+    cast_int<unsigned int>(_idx_buf[0]) : 0;
 }
 
 
@@ -750,7 +802,7 @@ unsigned int DofObject::n_vars(const unsigned int s,
 
   const unsigned int start_idx_sys = this->start_idx(s);
 
-  libmesh_assert_less ((start_idx_sys + 2*vg), _idx_buf.size());
+  libmesh_assert_less ((start_idx_sys + 2*vg), _idx_buf_size);
 
   return (cast_int<unsigned int>
           (_idx_buf[start_idx_sys + 2*vg]) >> ncv_magic_exp);
@@ -799,7 +851,7 @@ unsigned int DofObject::n_comp_group(const unsigned int s,
   const unsigned int
     start_idx_sys = this->start_idx(s);
 
-  libmesh_assert_less ((start_idx_sys + 2*vg), _idx_buf.size());
+  libmesh_assert_less ((start_idx_sys + 2*vg), _idx_buf_size);
 
   return (_idx_buf[start_idx_sys + 2*vg] % ncv_magic);
 }
@@ -819,7 +871,7 @@ dof_id_type DofObject::dof_number(const unsigned int s,
     vg            = this->var_to_vg(s,var),
     start_idx_sys = this->start_idx(s);
 
-  libmesh_assert_less ((start_idx_sys + 2*vg + 1), _idx_buf.size());
+  libmesh_assert_less ((start_idx_sys + 2*vg + 1), _idx_buf_size);
 
   const dof_id_type
     base_idx = _idx_buf[start_idx_sys + 2*vg + 1];
@@ -878,7 +930,7 @@ inline
 unsigned int DofObject::start_idx (const unsigned int s) const
 {
   libmesh_assert_less (s, this->n_systems());
-  libmesh_assert_less (s, _idx_buf.size());
+  libmesh_assert_less (s, _idx_buf_size);
 
   return cast_int<unsigned int>(_idx_buf[s]);
 }
@@ -889,10 +941,10 @@ inline
 unsigned int DofObject::end_idx (const unsigned int s) const
 {
   libmesh_assert_less (s, this->n_systems());
-  libmesh_assert_less (s, _idx_buf.size());
+  libmesh_assert_less (s, _idx_buf_size);
 
   return ((s+1) == this->n_systems()) ?
-    cast_int<unsigned int>(_idx_buf.size()) :
+    _idx_buf_size :
     cast_int<unsigned int>(_idx_buf[s+1]);
 }
 
@@ -909,7 +961,7 @@ void DofObject::set_vg_dof_base(const unsigned int s,
   const unsigned int
     start_idx_sys = this->start_idx(s);
 
-  libmesh_assert_less ((start_idx_sys + 2*vg + 1), _idx_buf.size());
+  libmesh_assert_less ((start_idx_sys + 2*vg + 1), _idx_buf_size);
 
   _idx_buf[start_idx_sys + 2*vg + 1] = db;
 
@@ -928,11 +980,11 @@ dof_id_type DofObject::vg_dof_base(const unsigned int s,
   const unsigned int
     start_idx_sys = this->start_idx(s);
 
-  libmesh_assert_less ((start_idx_sys + 2*vg + 1), _idx_buf.size());
+  libmesh_assert_less ((start_idx_sys + 2*vg + 1), _idx_buf_size);
 
   // #ifdef DEBUG
   //   std::cout << " [ ";
-  //   for (std:size_t i=0; i<_idx_buf.size(); i++)
+  //   for (std:size_t i=0; i<_idx_buf_size; i++)
   //     std::cout << _idx_buf[i] << " ";
   //   std::cout << "]\n";
   // #endif
@@ -0,0 +1,38 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_ENUM_DOF_REORDERING_TYPE_H
+#define LIBMESH_ENUM_DOF_REORDERING_TYPE_H
+
+// ------------------------------------------------------------
+// enum DofReorderingType definition
+namespace libMesh {
+
+/**
+ * \enum DofReorderingType defines an \p enum for the ways in which
+ * \p DofMap::distribute_dofs() can reorder the degrees of freedom
+ * owned by each processor to reduce matrix bandwidth or fill-in.
+ */
+enum DofReorderingType {NO_REORDERING = 0,
+                        REVERSE_CUTHILL_MCKEE,
+                        NESTED_DISSECTION,
+                        INVALID_REORDERING};
+}
+
+#endif // LIBMESH_ENUM_DOF_REORDERING_TYPE_H
@@ -32,6 +32,7 @@ namespace libMesh {
 enum PointLocatorType {TREE = 0,
                        TREE_ELEMENTS,
                        TREE_LOCAL_ELEMENTS,
+                       BVH,
                        INVALID_LOCATOR};
 }
 
@@ -77,6 +77,9 @@ public:
 
 protected:
 
+  virtual std::unique_ptr<JumpErrorEstimator> clone() const libmesh_override
+  { return libmesh_make_unique<DiscontinuityMeasure>(*this); }
+
   /**
    * An initialization function, for requesting specific data from the FE
    * objects
@@ -25,10 +25,13 @@
 #include "libmesh/dense_vector.h"
 #include "libmesh/error_estimator.h"
 #include "libmesh/fem_context.h"
+#include "libmesh/elem_range.h"
+#include "libmesh/mesh_faces.h"
 
 // C++ includes
 #include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace libMesh
@@ -61,6 +64,20 @@ public:
       fine_error(0),
       coarse_error(0) {}
 
+  /**
+   * Copy constructor.  Copies the settings of \p other, but not its
+   * contexts, which are only built while estimating the error.
+   */
+  JumpErrorEstimator(const JumpErrorEstimator & other)
+    : ErrorEstimator(other),
+      scale_by_n_flux_faces(other.scale_by_n_flux_faces),
+      integrate_boundary_sides(other.integrate_boundary_sides),
+      fine_context(),
+      coarse_context(),
+      fine_error(0),
+      coarse_error(0)
+  {}
+
   /**
    * Destructor.
    */
@@ -72,6 +89,14 @@ public:
    * estimate formula to estimate the error on each cell.
    * The estimated error is output in the vector
    * \p error_per_cell
+   *
+   * Each face of the active local elements (see MeshBase::active_local_faces())
+   * is integrated over once.  If the most derived class implements \p
+   * clone(), the faces are split between threads, each integrating
+   * with its own copy of the estimator; the result is the same for
+   * any number of threads.  A class deriving from an estimator which
+   * implements \p clone() must override it too, or the error is
+   * estimated on one thread.
    */
   virtual void estimate_error (const System & system,
                                ErrorVector & error_per_cell,
@@ -89,6 +114,17 @@ public:
   bool scale_by_n_flux_faces;
 
 protected:
+  /**
+   * \returns A copy of this estimator, with the same settings, for a
+   * thread to integrate with, or a null pointer if the derived class
+   * can't be copied, in which case the error is estimated on one
+   * thread.  A copy of a different type than this estimator, as
+   * returned by a base class' clone() for a derived class which
+   * doesn't override it, is ignored the same way.
+   */
+  virtual std::unique_ptr<JumpErrorEstimator> clone() const
+  { return std::unique_ptr<JumpErrorEstimator>(); }
+
   /**
    * A utility function to reinit the finite element data on elements sharing a
    * side
@@ -142,6 +178,116 @@ protected:
    * The variable number currently being evaluated
    */
   unsigned int var;
+
+private:
+
+  /**
+   * The error and flux face contributions found on some of the
+   * elements, in the order they were found, so that they can be
+   * summed in the same order however the elements were split
+   * between threads.
+   */
+  struct ErrorContributions
+  {
+    std::vector<std::pair<dof_id_type, ErrorVectorReal>> errors;
+    std::vector<std::pair<dof_id_type, float>> n_flux_faces;
+  };
+
+  /**
+   * Builds the contexts for integrating on \p system, and lets the
+   * derived class initialize them.
+   */
+  void init_contexts (const System & system);
+
+  /**
+   * Adds the contributions of the fine and coarse errors, and of
+   * their flux faces if \p count_flux_faces, after integrating on an
+   * internal side.
+   */
+  void add_internal_side_errors (ErrorContributions & contributions,
+                                 bool count_flux_faces);
+
+  /**
+   * Integrates over \p face, adding the contributions to \p
+   * contributions.
+   */
+  void estimate_face_error (const System & system,
+                            const MeshFace & face,
+                            ErrorContributions & contributions);
+
+#ifdef LIBMESH_ENABLE_AMR
+  /**
+   * Integrates over the sides of \p parent, all of whose children
+   * are active, using the projection of the solution onto it.
+   */
+  void estimate_on_parent (const System & system,
+                           const Elem * parent,
+                           ErrorContributions & contributions);
+#endif
+
+  /**
+   * Estimates the contributions of \p range, on multiple threads if
+   * \p use_copies, and sums them into \p error_per_cell and \p
+   * n_flux_faces in range order.
+   */
+  template <typename RangeType>
+  void add_contributions (const System & system,
+                          const RangeType & range,
+                          bool use_copies,
+                          ErrorVector & error_per_cell,
+                          std::vector<float> & n_flux_faces);
+
+  /**
+   * Class to compute the error contributions of a range of faces, or
+   * of parent elements.  May be executed in parallel on separate
+   * threads.
+   */
+  class EstimateError
+  {
+  public:
+    EstimateError (const System & sys,
+                   JumpErrorEstimator & ee,
+                   bool copies,
+                   std::vector<std::pair<std::size_t, ErrorContributions>> & rs) :
+      system(sys),
+      error_estimator(ee),
+      use_copies(copies),
+      results(rs)
+    {}
+
+    void operator()(const ConstMeshFaceRange & range) const;
+
+    void operator()(const ConstElemRange & range) const;
+
+  private:
+    /**
+     * \returns The estimator to integrate with: a \p clone() of \p
+     * error_estimator if \p use_copies, with its contexts initialized.
+     */
+    JumpErrorEstimator & estimator (std::unique_ptr<JumpErrorEstimator> & copy) const;
+
+    /**
+     * Stores the contributions of the range starting at \p first_idx.
+     */
+    void store (std::size_t first_idx,
+                ErrorContributions & contributions) const;
+
+    const System & system;
+    JumpErrorEstimator & error_estimator;
+
+    /**
+     * Whether to integrate with a \p clone() of \p error_estimator.
+     */
+    const bool use_copies;
+
+    /**
+     * The contributions of each range done, with the index of its
+     * first element.
+     */
+    std::vector<std::pair<std::size_t, ErrorContributions>> & results;
+  };
+
+  friend class EstimateError;
 };
 
 
@@ -589,6 +589,14 @@ protected:
    */
   bool shapes_on_quadrature;
 
+  /**
+   * A flag indicating that \p phi was copied from a table of
+   * reference shape function values which are the same on every
+   * element of the current type, so that it need not be recomputed
+   * when only the element geometry changes.
+   */
+  bool phi_from_reference_cache;
+
   /**
    * \returns \p true when the shape functions (for
    * this \p FEFamily) depend on the particular
@@ -620,7 +628,8 @@ FEAbstract::FEAbstract(const unsigned int d,
   elem_type(INVALID_ELEM),
   _p_level(0),
   qrule(libmesh_nullptr),
-  shapes_on_quadrature(false)
+  shapes_on_quadrature(false),
+  phi_from_reference_cache(false)
 {
 }
 
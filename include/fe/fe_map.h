@@ -101,6 +101,84 @@ public:
                            const Elem * elem,
                            bool calculate_d2phi);
 
+  /**
+   * Map data at the quadrature points of a batch of elements, stored
+   * in structure-of-arrays layout: each field holds \p n_qp blocks
+   * of \p n_elem values, so that the value for element \p e at
+   * quadrature point \p p is at index(e,p), and values for
+   * neighboring elements are adjacent.  Inverse map entries
+   * which do not exist for the batch dimension are left empty.
+   */
+  struct BatchData
+  {
+    BatchData() :
+      n_elem(0), n_qp(0),
+      ref_type(INVALID_ELEM), ref_n_nodes(0), ref_dim(0) {}
+
+    unsigned int n_elem;
+    unsigned int n_qp;
+
+    std::size_t index (unsigned int e, unsigned int p) const
+    { return std::size_t(p)*n_elem + e; }
+
+    /**
+     * Physical locations of the quadrature points.
+     */
+    std::vector<Real> x, y, z;
+
+    /**
+     * Jacobian and Jacobian*Weight values.
+     */
+    std::vector<Real> jac, JxW;
+
+    /**
+     * Inverse map derivatives.
+     */
+    std::vector<Real> dxidx, dxidy, dxidz;
+    std::vector<Real> detadx, detady, detadz;
+    std::vector<Real> dzetadx, dzetady, dzetadz;
+
+    /**
+     * Mapping shape functions (and their reference derivatives) at
+     * the quadrature points, cached between batches of the same
+     * element type and quadrature points.  Entry i*n_qp+p holds
+     * shape function i at point p.
+     */
+    std::vector<Real> ref_phi, ref_dphi[3];
+    ElemType ref_type;
+    unsigned int ref_n_nodes;
+    unsigned int ref_dim;
+    std::vector<Point> ref_points;
+
+    /**
+     * Work space for the forward map derivatives and node
+     * coordinates of the batch.
+     */
+    std::vector<Real> dxyz[3][3];
+    std::vector<Real> node_coords[3];
+  };
+
+  /**
+   * Computes quadrature point locations, Jacobians, inverse Jacobians
+   * and JxW for all of the elements \p elems at once, writing them to
+   * \p data.  The elements must all have the same type and dimension
+   * \p dim, and \p qp and \p qw are the reference quadrature points
+   * and weights to use on each of them.
+   *
+   * Unlike compute_map(), this doesn't touch any per-object state, so
+   * one FEMap (or none; this is static) can serve many threads as
+   * long as each has its own \p data.  The work is organized as
+   * unit-stride loops over the whole batch so that the compiler can
+   * vectorize it; this is worthwhile on blocks of a few dozen
+   * elements or more.  Second derivatives of the map are not
+   * computed.
+   */
+  static void compute_batch_map(const unsigned int dim,
+                                const std::vector<Point> & qp,
+                                const std::vector<Real> & qw,
+                                const std::vector<const Elem *> & elems,
+                                BatchData & data);
+
   /**
    * Same as compute_map, but for a side.  Useful for boundary integration.
    */
@@ -34,6 +34,7 @@
 namespace libMesh
 {
 // Forward declarations
+class BackgroundWriter;
 class Xdr;
 
 /**
@@ -105,6 +106,15 @@ public:
   bool   parallel() const { return _parallel; }
   bool & parallel()       { return _parallel; }
 
+  /**
+   * Get/Set the \p BackgroundWriter to write files with.  If one is
+   * set, \p write() returns once the mesh has been gathered into
+   * memory, and the files are written on background threads; call
+   * its \p wait() before relying on them being on disk.
+   */
+  BackgroundWriter *   background_writer() const { return _background_writer; }
+  BackgroundWriter * & background_writer()       { return _background_writer; }
+
   /**
    * Get/Set the version string.
    */
@@ -260,6 +270,9 @@ private:
   bool _parallel;
   std::string _version;
 
+  // Where to hand files to be written in the background, if anywhere
+  BackgroundWriter * _background_writer;
+
   // The processor ids to write
   std::vector<processor_id_type> _my_processor_ids;
 
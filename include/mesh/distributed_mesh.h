@@ -21,7 +21,7 @@
 #define LIBMESH_DISTRIBUTED_MESH_H
 
 // Local Includes
-#include "libmesh/mapvector.h"
+#include "libmesh/paged_mapvector.h"
 #include "libmesh/unstructured_mesh.h"
 
 // C++ Includes
@@ -151,7 +151,7 @@ public:
    * Calls libmesh_assert() on each possible failure in that container.
    */
   template <typename T>
-  void libmesh_assert_valid_parallel_object_ids(const mapvector<T *,dof_id_type> &) const;
+  void libmesh_assert_valid_parallel_object_ids(const paged_mapvector<T *,dof_id_type> &) const;
 
   /**
    * Verify id and processor_id consistency of our elements and
@@ -179,7 +179,7 @@ public:
    * \returns The smallest globally unused id for that container.
    */
   template <typename T>
-  dof_id_type renumber_dof_objects (mapvector<T *,dof_id_type> &);
+  dof_id_type renumber_dof_objects (paged_mapvector<T *,dof_id_type> &);
 
   /**
    * Remove NULL elements from arrays
@@ -521,12 +521,12 @@ protected:
   /**
    * The vertices (spatial coordinates) of the mesh.
    */
-  mapvector<Node *, dof_id_type> _nodes;
+  paged_mapvector<Node *, dof_id_type> _nodes;
 
   /**
    * The elements in the mesh.
    */
-  mapvector<Elem *, dof_id_type> _elements;
+  paged_mapvector<Elem *, dof_id_type> _elements;
 
   /**
    * A boolean remembering whether we're serialized or not
@@ -569,17 +569,17 @@ private:
 
   /**
    * Typedefs for the container implementation.  In this case,
-   * it's just a std::vector<Elem *>.
+   * it's a paged_mapvector<Elem *>.
    */
-  typedef mapvector<Elem *, dof_id_type>::veclike_iterator             elem_iterator_imp;
-  typedef mapvector<Elem *, dof_id_type>::const_veclike_iterator const_elem_iterator_imp;
+  typedef paged_mapvector<Elem *, dof_id_type>::veclike_iterator             elem_iterator_imp;
+  typedef paged_mapvector<Elem *, dof_id_type>::const_veclike_iterator const_elem_iterator_imp;
 
   /**
    * Typedefs for the container implementation.  In this case,
-   * it's just a std::vector<Node *>.
+   * it's a paged_mapvector<Node *>.
    */
-  typedef mapvector<Node *, dof_id_type>::veclike_iterator             node_iterator_imp;
-  typedef mapvector<Node *, dof_id_type>::const_veclike_iterator const_node_iterator_imp;
+  typedef paged_mapvector<Node *, dof_id_type>::veclike_iterator             node_iterator_imp;
+  typedef paged_mapvector<Node *, dof_id_type>::const_veclike_iterator const_node_iterator_imp;
 };
 
 
@@ -0,0 +1,150 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_ELEMENT_BLOCKS_H
+#define LIBMESH_ELEMENT_BLOCKS_H
+
+// Local Includes
+#include "libmesh/elem_range.h"
+
+// C++ Includes
+#include <memory>
+#include <vector>
+
+namespace libMesh
+{
+
+// Forward declarations
+class Elem;
+class MeshBase;
+
+/**
+ * This class subdivides the active local elements of a mesh, the
+ * ones a processor was given by the mesh Partitioner, a second time:
+ * into compact blocks for the threads on that processor to work on.
+ *
+ * The elements are sorted along a Hilbert curve through their
+ * centroids (or left in mesh iteration order if libMesh was built
+ * without libHilbert), and the curve is cut into \p n_blocks blocks
+ * of roughly equal work, typically one per thread, so each block is
+ * a spatially compact set of elements with a compact set of nodes
+ * and dofs.  The blocks are then shared out in runs of consecutive
+ * blocks between \p n_groups groups, typically one per NUMA domain,
+ * so the threads of a group work on neighboring parts of the mesh.
+ *
+ * The blocks are stored one after another, so \p range() over all
+ * of them is itself in curve order.  The pthreads backend of
+ * Threads::parallel_for() initially gives each thread a contiguous
+ * part of a range, so a loop over \p range() gets locality without
+ * further effort, while a loop over \p range(b) lets a caller map
+ * blocks to threads explicitly.
+ *
+ * The work of an element is estimated by its number of nodes.
+ *
+ * \brief Locality-preserving blocks of the active local elements of a mesh.
+ */
+class ElementBlocks
+{
+public:
+
+  /**
+   * Constructor.  Splits the active local elements of \p mesh into
+   * \p n_groups groups of, in total, \p n_blocks blocks.  Neither may
+   * be zero, and there are at least as many blocks as groups.
+   */
+  ElementBlocks (const MeshBase & mesh,
+                 unsigned int n_blocks,
+                 unsigned int n_groups = 1);
+
+  /**
+   * \returns The number of blocks.
+   */
+  unsigned int n_blocks () const
+  { return cast_int<unsigned int>(_block_ranges.size()); }
+
+  /**
+   * \returns The number of groups.
+   */
+  unsigned int n_groups () const
+  { return cast_int<unsigned int>(_group_first_block.size() - 1); }
+
+  /**
+   * \returns The first block of group \p g; its blocks are numbered
+   * from there up to the first block of group \p g+1.
+   */
+  unsigned int first_block (unsigned int g) const
+  {
+    libmesh_assert_less (g, this->n_groups());
+    return _group_first_block[g];
+  }
+
+  /**
+   * \returns All the elements, in curve order.
+   */
+  const std::vector<const Elem *> & elements () const
+  { return _elems; }
+
+  /**
+   * \returns A threadable range over all the elements, in curve
+   * order.  The \p first_idx() of its subranges index \p elements().
+   */
+  const ConstElemRange & range () const
+  { return *_range; }
+
+  /**
+   * \returns A threadable range over the elements of block \p b.
+   */
+  const ConstElemRange & range (unsigned int b) const
+  {
+    libmesh_assert_less (b, _block_ranges.size());
+    return *_block_ranges[b];
+  }
+
+  /**
+   * \returns A threadable range over the elements of group \p g.
+   */
+  const ConstElemRange & group_range (unsigned int g) const
+  {
+    libmesh_assert_less (g, _group_ranges.size());
+    return *_group_ranges[g];
+  }
+
+private:
+
+  /**
+   * The elements, in curve order.
+   */
+  std::vector<const Elem *> _elems;
+
+  /**
+   * The first block of each group, followed by the number of blocks.
+   */
+  std::vector<unsigned int> _group_first_block;
+
+  /**
+   * Ranges referring to \p _elems.
+   */
+  std::unique_ptr<ConstElemRange> _range;
+  std::vector<std::unique_ptr<ConstElemRange>> _block_ranges;
+  std::vector<std::unique_ptr<ConstElemRange>> _group_ranges;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_ELEMENT_BLOCKS_H
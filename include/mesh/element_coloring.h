@@ -0,0 +1,132 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_ELEMENT_COLORING_H
+#define LIBMESH_ELEMENT_COLORING_H
+
+// Local Includes
+#include "libmesh/elem_range.h"
+
+// C++ Includes
+#include <memory>
+#include <vector>
+
+namespace libMesh
+{
+
+// Forward declarations
+class DofMap;
+class Elem;
+class MeshBase;
+
+/**
+ * This class partitions the active local elements of a mesh into
+ * "colors" such that no two elements of the same color share a node,
+ * so that threads working on elements of a single color never write
+ * to the same node-based degrees of freedom.  Elements which have a
+ * coarser face neighbor (at hanging nodes on adaptively refined
+ * meshes) are also treated as touching all of that neighbor's nodes,
+ * since constraint application moves their contributions there.
+ *
+ * A typical threaded loop then looks like
+ * \code
+ * const ElementColoring & coloring = mesh.active_local_element_coloring();
+ * for (unsigned int c=0; c != coloring.n_colors(); ++c)
+ *   Threads::parallel_for(coloring.range(c), body);
+ * \endcode
+ *
+ * Degrees of freedom which are not associated with nodes of the
+ * elements in question (SCALAR variables, or constraints between
+ * non-neighboring elements such as periodic boundary conditions) are
+ * not accounted for by this mesh coloring, and neither are hanging
+ * nodes on the edges of 3D elements or constraints which refer to
+ * other constrained nodes.  A coloring of the elements by the
+ * constrained dofs of a particular system, which does account for
+ * all of these, is available from
+ * DofMap::active_local_element_coloring().
+ *
+ * Colors are assigned greedily in element iteration order, so the
+ * coloring is deterministic for a given mesh and partitioning.
+ *
+ * \brief Race-free coloring of the active local elements of a mesh.
+ */
+class ElementColoring
+{
+public:
+
+  /**
+   * Constructor.  Colors the active local elements of \p mesh.
+   */
+  explicit
+  ElementColoring (const MeshBase & mesh);
+
+  /**
+   * Constructor.  Colors the active local elements of the mesh of \p
+   * dof_map so that no two elements of the same color touch the same
+   * dof, where an element touches its own dofs and every dof which
+   * constraints on those refer to, directly or in turn.
+   */
+  explicit
+  ElementColoring (const DofMap & dof_map);
+
+  /**
+   * \returns The number of colors used.
+   */
+  unsigned int n_colors () const
+  { return cast_int<unsigned int>(_elems.size()); }
+
+  /**
+   * \returns The elements of color \p c, in mesh iteration order.
+   */
+  const std::vector<const Elem *> & elements (unsigned int c) const
+  {
+    libmesh_assert_less (c, _elems.size());
+    return _elems[c];
+  }
+
+  /**
+   * \returns A threadable range over the elements of color \p c.
+   */
+  const ConstElemRange & range (unsigned int c) const
+  {
+    libmesh_assert_less (c, _ranges.size());
+    return *_ranges[c];
+  }
+
+private:
+
+  /**
+   * Builds \p _ranges once \p _elems is filled.
+   */
+  void build_ranges ();
+
+  /**
+   * The elements of each color.
+   */
+  std::vector<std::vector<const Elem *>> _elems;
+
+  /**
+   * Ranges referring to the vectors in \p _elems.
+   */
+  std::vector<std::unique_ptr<ConstElemRange>> _ranges;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_ELEMENT_COLORING_H
@@ -41,6 +41,9 @@ namespace libMesh
 
 // forward declarations
 class Elem;
+class ElementBlocks;
+class MeshFaces;
+class ElementColoring;
 class GhostingFunctor;
 class Node;
 class Point;
@@ -758,6 +761,20 @@ public:
   void allow_remote_element_removal(bool allow) { _allow_remote_element_removal = allow; }
   bool allow_remote_element_removal() const { return _allow_remote_element_removal; }
 
+  /**
+   * If true is passed in then renumber_nodes_and_elements() will
+   * number the elements on each processor, and then the nodes, in the
+   * order of a Hilbert space-filling curve through them, so that
+   * elements and nodes which are close together in space are also
+   * close together in memory and in dof numbering.  Coarser elements
+   * still precede finer ones.
+   *
+   * This is false by default, and has no effect if renumbering is not
+   * allowed or if libMesh was built without libHilbert.
+   */
+  void allow_sfc_renumbering(bool allow) { _allow_sfc_renumbering = allow; }
+  bool allow_sfc_renumbering() const { return _allow_sfc_renumbering; }
+
   /**
    * If true is passed in then this mesh will no longer be
    * (re)partitioned.  It would probably be a bad idea to call this on
@@ -774,6 +791,27 @@ public:
   void skip_partitioning(bool skip) { _skip_partitioning = skip; }
   bool skip_partitioning() const { return _skip_partitioning; }
 
+  /**
+   * If true is passed in then, each time DoFs are distributed, the
+   * DoF indexing of all nodes and elements will be packed into one
+   * contiguous array owned by this mesh (see compact_dof_indexing())
+   * rather than kept in a separately allocated buffer per object.
+   * This saves memory and makes DoF index lookups during assembly
+   * more cache friendly on large meshes.
+   */
+  void allow_dof_index_arena(bool allow) { _allow_dof_index_arena = allow; }
+  bool allow_dof_index_arena() const { return _allow_dof_index_arena; }
+
+  /**
+   * Packs the DoF indexing of every node and element on this
+   * processor into one contiguous array owned by the mesh, replacing
+   * any array packed previously.  Objects whose indexing layout
+   * changes later (e.g. when variables are added, or after
+   * refinement) transparently move back to storage of their own
+   * until the next call.
+   */
+  void compact_dof_indexing ();
+
   /**
    * Adds a functor which can specify ghosting requirements for use on
    * distributed meshes.  Multiple ghosting functors can be added; any
@@ -943,6 +981,71 @@ public:
    */
   void clear_point_locator ();
 
+  /**
+   * \returns A coloring of the active local elements of this mesh
+   * (see ElementColoring), computing it first if necessary.  The
+   * coloring is cached until clear_element_caches() is next called,
+   * and should not first be requested from within threaded code.
+   */
+  const ElementColoring & active_local_element_coloring () const;
+
+  /**
+   * Releases the current element coloring, if any.
+   */
+  void clear_element_coloring ();
+
+  /**
+   * \returns The active local elements of this mesh split into one
+   * locality-preserving block per thread (see ElementBlocks), in \p
+   * n_element_block_groups() groups, computing them first if
+   * necessary.  The blocks are cached until clear_element_caches() is
+   * next called or the number of threads or groups changes, and
+   * should not first be requested from within threaded code.
+   */
+  const ElementBlocks & active_local_element_blocks () const;
+
+  /**
+   * Releases the current element blocks, if any.
+   */
+  void clear_element_blocks ();
+
+  /**
+   * Sets the number of groups active_local_element_blocks() splits
+   * the threads' blocks into.  Use the number of NUMA domains the
+   * threads of each processor run on, so that each domain's threads
+   * work on one compact part of the processor's elements.  Defaults
+   * to 1.
+   */
+  void set_n_element_block_groups (unsigned int n_groups);
+
+  /**
+   * \returns The number of groups set by set_n_element_block_groups().
+   */
+  unsigned int n_element_block_groups () const
+  { return _n_element_block_groups; }
+
+  /**
+   * \returns Each face of the active local elements of this mesh,
+   * listed once (see MeshFaces), computing them first if necessary.
+   * The faces are cached until clear_element_caches() is next called,
+   * and should not first be requested from within threaded code.
+   */
+  const MeshFaces & active_local_faces () const;
+
+  /**
+   * Releases the current face list, if any.
+   */
+  void clear_active_local_faces ();
+
+  /**
+   * Releases the cached element coloring, element blocks and face
+   * list, if any.  This is done whenever the mesh is prepared,
+   * partitioned, redistributed or cleared, and whenever elements are
+   * added, deleted or renumbered, since each of those can change the
+   * set of active local elements.
+   */
+  void clear_element_caches ();
+
   /**
    * In the point locator, do we count lower dimensional elements
    * when we refine point locator regions? This is relevant in
@@ -1361,6 +1464,26 @@ protected:
    */
   bool _count_lower_dim_elems_in_point_locator;
 
+  /**
+   * The cached coloring of active local elements.  Like the point
+   * locator, this is built on demand from a const method, so it needs
+   * to be mutable.
+   */
+  mutable std::unique_ptr<ElementColoring> _element_coloring;
+
+  /**
+   * The cached thread blocks of active local elements, and the
+   * number of groups to build them with.
+   */
+  mutable std::unique_ptr<ElementBlocks> _element_blocks;
+
+  unsigned int _n_element_block_groups;
+
+  /**
+   * The cached faces of active local elements.
+   */
+  mutable std::unique_ptr<MeshFaces> _active_local_faces;
+
   /**
    * A partitioner to use at each prepare_for_use().
    *
@@ -1388,6 +1511,14 @@ protected:
    */
   bool _skip_renumber_nodes_and_elements;
 
+  /**
+   * If this is true then renumbering orders nodes and elements along
+   * a space-filling curve.
+   *
+   * This is false by default.
+   */
+  bool _allow_sfc_renumbering;
+
   /**
    * If this is false then even on DistributedMesh remote elements
    * will not be deleted during mesh preparation.
@@ -1396,6 +1527,20 @@ protected:
    */
   bool _allow_remote_element_removal;
 
+  /**
+   * If this is true then DoF indexing is packed into
+   * \p _dof_index_arena whenever DoFs are distributed.
+   *
+   * This is false by default.
+   */
+  bool _allow_dof_index_arena;
+
+  /**
+   * Contiguous storage for the DoF indexing of our nodes and
+   * elements, used when allow_dof_index_arena() is true.
+   */
+  std::vector<dof_id_type> _dof_index_arena;
+
   /**
    * This structure maintains the mapping of named blocks
    * for file formats that support named blocks.  Currently
@@ -0,0 +1,161 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_MESH_FACES_H
+#define LIBMESH_MESH_FACES_H
+
+// Local Includes
+#include "libmesh/id_types.h"
+#include "libmesh/libmesh_common.h"
+#include "libmesh/stored_range.h"
+
+// C++ Includes
+#include <memory>
+#include <vector>
+
+namespace libMesh
+{
+
+// Forward declarations
+class Elem;
+class MeshBase;
+
+/**
+ * One side shared by two active elements, or one active element side
+ * on the boundary of the domain.
+ *
+ * Where the two elements are at different refinement levels, \p elem
+ * is the finer one and the face is its whole side but only part of
+ * the side of \p neighbor.  Where they are at the same level, \p elem
+ * is the one with the smaller id.
+ */
+struct MeshFace
+{
+  /**
+   * The element whose whole side the face is.
+   */
+  const Elem * elem;
+
+  /**
+   * The side of \p elem.
+   */
+  unsigned int side;
+
+  /**
+   * The element on the other side of the face, or \p libmesh_nullptr
+   * on the boundary.
+   */
+  const Elem * neighbor;
+
+  /**
+   * The side of \p neighbor the face is on, or \p invalid_uint on the
+   * boundary.
+   */
+  unsigned int neighbor_side;
+
+  /**
+   * How many levels finer \p elem is than \p neighbor; 0 on the
+   * boundary.
+   */
+  unsigned int level_difference;
+
+  /**
+   * The processor which integrates on the face: the owner of \p elem.
+   */
+  processor_id_type processor_id;
+
+  /**
+   * \returns \p true if the face is on the boundary of the domain.
+   */
+  bool on_boundary () const
+  { return !neighbor; }
+};
+
+typedef StoredRange<std::vector<MeshFace>::const_iterator, MeshFace> ConstMeshFaceRange;
+
+/**
+ * This class lists each face of the active local elements of a mesh
+ * exactly once, so that loops integrating over faces (jump error
+ * estimators, DG assembly) do each integration once rather than
+ * visiting every interior face from both sides and skipping half.
+ *
+ * Faces between a local element and a remote one are listed on the
+ * processor that owns the finer element, or the element with the
+ * smaller id at the same level, so that each face of the mesh is
+ * listed on exactly one processor.  The faces of each element are
+ * listed together, in element iteration order, so a loop which
+ * reinitializes an element only when it changes does so once per
+ * element.
+ *
+ * A typical threaded face loop then looks like
+ * \code
+ * Threads::parallel_for(mesh.active_local_faces().range(), body);
+ * \endcode
+ * where \p body reinitializes one context on \p elem and \p side and,
+ * unless \p on_boundary(), a second context on \p neighbor and \p
+ * neighbor_side.
+ *
+ * \brief The faces of the active local elements of a mesh.
+ */
+class MeshFaces
+{
+public:
+
+  /**
+   * Constructor.  Lists the faces of the active local elements of \p
+   * mesh.
+   */
+  explicit
+  MeshFaces (const MeshBase & mesh);
+
+  /**
+   * \returns The number of faces.
+   */
+  std::size_t n_faces () const
+  { return _faces.size(); }
+
+  /**
+   * \returns All the faces.
+   */
+  const std::vector<MeshFace> & faces () const
+  { return _faces; }
+
+  /**
+   * \returns A threadable range over all the faces.  The \p
+   * first_idx() of its subranges index \p faces().
+   */
+  const ConstMeshFaceRange & range () const
+  { return *_range; }
+
+private:
+
+  /**
+   * The faces, grouped by \p elem.
+   */
+  std::vector<MeshFace> _faces;
+
+  /**
+   * A range referring to \p _faces.
+   */
+  std::unique_ptr<ConstMeshFaceRange> _range;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_MESH_FACES_H
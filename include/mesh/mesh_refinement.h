@@ -524,6 +524,21 @@ private:
    */
   bool _refine_elements ();
 
+  /**
+   * Refines \p elems, which must be all the elements flagged for
+   * refinement, in the order _refine_elements() would refine them,
+   * building their children and new nodes on multiple threads.
+   * Nodes and elements are added to the mesh afterwards, in the
+   * order Elem::refine() would add them, so the refined mesh is the
+   * same however many threads are used.
+   *
+   * \returns \p false, having done nothing, if some element needs
+   * the nodes of its earlier children to find those of its later
+   * ones, as non-full-order second-order elements do, and so has to
+   * be refined by Elem::refine().
+   */
+  bool _refine_elements_threaded (const std::vector<Elem *> & elems);
+
   /**
    * Smooths refinement flags according to current settings.  It is
    * possible that for a given set of refinement flags there is
@@ -386,6 +386,25 @@ void find_hanging_nodes_and_parents(const MeshBase & mesh,
  */
 void correct_node_proc_ids(MeshBase &);
 
+/**
+ * Sorts \p elems along a Hilbert space-filling curve through the
+ * bounding box of their centroids, so that elements which are close
+ * together in space end up close together in the vector.  Ties are
+ * broken by the original order.
+ *
+ * Only the given elements are examined, so this is not a parallel
+ * operation.  It does nothing if libMesh was built without
+ * libHilbert.
+ */
+void sort_along_hilbert_curve (std::vector<const Elem *> & elems);
+void sort_along_hilbert_curve (std::vector<Elem *> & elems);
+
+/**
+ * Sorts \p nodes along a Hilbert space-filling curve through the
+ * bounding box of their positions, as above.
+ */
+void sort_along_hilbert_curve (std::vector<Node *> & nodes);
+
 
 #ifdef DEBUG
 /**
@@ -94,7 +94,29 @@ public:
 
   virtual void zero () libmesh_override;
 
-  virtual void close () libmesh_override { this->_closed = true; }
+  /**
+   * If \p keep is \p true, zero() keeps the nonzero structure of the
+   * matrix and only zeroes the stored entries, as PETSc's
+   * MatZeroEntries() does, rather than discarding it.  Explicit
+   * zeros are kept in the matrix as a result.  Off by default.
+   *
+   * Inserting a new entry may reallocate Eigen's storage, so threads
+   * may only add to different rows at once when every entry they add
+   * to already exists.  With the pattern kept, supports_concurrent_add()
+   * therefore returns \p true once the matrix has been closed, on the
+   * assumption that later assemblies add to the same entries as the
+   * first.
+   */
+  void keep_nonzero_pattern (bool keep) { _keep_nonzero_pattern = keep; }
+
+  virtual bool supports_concurrent_add() const libmesh_override
+  { return _keep_nonzero_pattern && _pattern_complete; }
+
+  virtual void close () libmesh_override
+  {
+    this->_closed = true;
+    _pattern_complete = _keep_nonzero_pattern;
+  }
 
   virtual numeric_index_type m () const libmesh_override;
 
@@ -148,6 +170,17 @@ private:
    */
   bool _closed;
 
+  /**
+   * Whether zero() keeps the nonzero structure.
+   */
+  bool _keep_nonzero_pattern;
+
+  /**
+   * Whether the matrix has been closed since its entries were last
+   * discarded, so that its nonzero structure is assumed complete.
+   */
+  bool _pattern_complete;
+
   /**
    * Make other Eigen datatypes friends
    */
@@ -104,6 +104,12 @@ public:
 
   virtual void zero () libmesh_override;
 
+  /**
+   * Entries are plain array elements, so threads may add to
+   * different entries at once.
+   */
+  virtual bool supports_concurrent_add() const libmesh_override { return true; }
+
   virtual std::unique_ptr<NumericVector<T>> zero_clone () const libmesh_override;
 
   virtual std::unique_ptr<NumericVector<T>> clone () const libmesh_override;
@@ -136,6 +136,13 @@ public:
    */
   virtual bool initialized() const { return _is_initialized; }
 
+  /**
+   * \returns \p true if \p add_vector() may be called by several
+   * threads at once, as long as no two of them add to the same
+   * entry.  This is false unless a subclass says otherwise.
+   */
+  virtual bool supports_concurrent_add() const { return false; }
+
   /**
    * \returns The type (SERIAL, PARALLEL, GHOSTED) of the vector.
    */
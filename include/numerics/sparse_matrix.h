@@ -117,6 +117,17 @@ public:
   virtual bool need_full_sparsity_pattern() const
   { return false; }
 
+  /**
+   * \returns \p true if \p add_matrix() may be called by several
+   * threads at once, as long as no two of them add to the same row.
+   *
+   * This is false unless a subclass says otherwise; \p
+   * EigenSparseMatrix allows it once told to keep its nonzero
+   * pattern, and \p PetscMatrix never does.
+   */
+  virtual bool supports_concurrent_add() const
+  { return false; }
+
   /**
    * Updates the matrix sparsity pattern. When your \p SparseMatrix<T>
    * implementation does not need this data, simply do not override
@@ -700,6 +700,16 @@ public:
    */
   MessageTag get_unique_tag(int tagvalue) const;
 
+  /**
+   * Get a tag that is unique to this Communicator, and that differs
+   * from the tags returned by recent previous calls even if those
+   * have since been released.  Operations which might still be
+   * receiving messages on some processors after others have moved
+   * on, such as \p push_parallel_vector_data(), can use this to
+   * avoid intercepting messages meant for the next such operation.
+   */
+  MessageTag get_unique_tag() const;
+
   /**
    * Reference an already-acquired tag, so that we know it will
    * be dereferenced multiple times before we can re-release it.
@@ -748,6 +758,12 @@ private:
   // mutable used_tag_values - not thread-safe, but then Parallel::
   // isn't thread-safe in general.
   mutable std::map<int, unsigned int> used_tag_values;
+
+  // The tag to try next in get_unique_tag(), and the range of tags
+  // it cycles through
+  mutable int _next_tag_value;
+  static const int first_cycled_tag = 20000;
+  static const int end_cycled_tag = 30000;
   bool          _I_duped_it;
 
   // Communication operations:
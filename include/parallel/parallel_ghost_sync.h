@@ -26,6 +26,13 @@
 #include "libmesh/location_maps.h"
 #include "libmesh/mesh_base.h"
 #include "libmesh/parallel.h"
+#include "libmesh/parallel_algebra.h"
+#include "libmesh/parallel_sync.h"
+
+// C++ includes
+#include <map>
+#include <utility>
+#include <vector>
 
 
 namespace libMesh
@@ -171,6 +178,183 @@ struct SyncEverything
 
 
 
+// Functors which adapt a SyncFunctor to the interface of
+// pull_parallel_vector_data().  Queried objects are identified to
+// their owners by id, by location, by parent and child number, or by
+// element and local node number; responses are acted on with the
+// ids of the objects we asked each processor about.
+template <typename SyncFunctor>
+struct SyncGatherById
+{
+  SyncGatherById(SyncFunctor & s) : sync(s) {}
+
+  void operator() (processor_id_type,
+                   const std::vector<dof_id_type> & ids,
+                   std::vector<typename SyncFunctor::datum> & data)
+  {
+    sync.gather_data(ids, data);
+  }
+
+  SyncFunctor & sync;
+};
+
+
+template <typename DofObjType,
+          typename SyncFunctor>
+struct SyncGatherByXyz
+{
+  SyncGatherByXyz(LocationMap<DofObjType> & m, SyncFunctor & s) :
+    location_map(m), sync(s) {}
+
+  void operator() (processor_id_type,
+                   const std::vector<Point> & pts,
+                   std::vector<typename SyncFunctor::datum> & data)
+  {
+    // Find the local id of each requested object
+    std::vector<dof_id_type> ids(pts.size());
+    for (std::size_t i=0; i != pts.size(); ++i)
+      {
+        // Look for this object in the multimap
+        DofObjType * obj = location_map.find(pts[i]);
+
+        // We'd better find every object we're asked for
+        libmesh_assert (obj);
+
+        // Return the object's correct processor id,
+        // and our (correct if it's local) id for it.
+        ids[i] = obj->id();
+      }
+
+    sync.gather_data(ids, data);
+  }
+
+  LocationMap<DofObjType> & location_map;
+  SyncFunctor & sync;
+};
+
+
+template <typename SyncFunctor>
+struct SyncGatherByParentId
+{
+  SyncGatherByParentId(MeshBase & m, SyncFunctor & s) :
+    mesh(m), sync(s) {}
+
+  void operator() (processor_id_type,
+                   const std::vector<std::pair<dof_id_type, unsigned char>> & children,
+                   std::vector<typename SyncFunctor::datum> & data)
+  {
+    // Find the id of each requested element
+    std::vector<dof_id_type> ids(children.size());
+    for (std::size_t i=0; i != children.size(); ++i)
+      {
+        Elem & parent = mesh.elem_ref(children[i].first);
+        libmesh_assert(parent.has_children());
+        Elem * child = parent.child_ptr(children[i].second);
+        libmesh_assert(child);
+        libmesh_assert(child->active());
+        ids[i] = child->id();
+      }
+
+    sync.gather_data(ids, data);
+  }
+
+  MeshBase & mesh;
+  SyncFunctor & sync;
+};
+
+
+template <typename SyncFunctor>
+struct SyncGatherByElementId
+{
+  SyncGatherByElementId(MeshBase & m, SyncFunctor & s) :
+    mesh(m), sync(s) {}
+
+  void operator() (processor_id_type,
+                   const std::vector<std::pair<dof_id_type, unsigned char>> & elem_nodes,
+                   std::vector<typename SyncFunctor::datum> & data)
+  {
+    // Find the id of each requested node
+    std::vector<dof_id_type> ids(elem_nodes.size());
+    for (std::size_t i=0; i != elem_nodes.size(); ++i)
+      {
+        const Elem & elem = mesh.elem_ref(elem_nodes[i].first);
+
+        const unsigned int n = elem_nodes[i].second;
+        libmesh_assert_less (n, elem.n_nodes());
+
+        const Node & node = elem.node_ref(n);
+
+        // This isn't a safe assertion in the case where we're
+        // syncing processor ids
+        // libmesh_assert_equal_to (node->processor_id(), comm.rank());
+
+        ids[i] = node.id();
+      }
+
+    sync.gather_data(ids, data);
+  }
+
+  MeshBase & mesh;
+  SyncFunctor & sync;
+};
+
+
+template <typename SyncFunctor>
+struct SyncActOnData
+{
+  SyncActOnData(const std::map<processor_id_type, std::vector<dof_id_type>> & ids,
+                SyncFunctor & s) :
+    requested_objs_id(ids), sync(s) {}
+
+  template <typename QueryVector>
+  void operator() (processor_id_type pid,
+                   const QueryVector &,
+                   std::vector<typename SyncFunctor::datum> & data)
+  {
+    std::map<processor_id_type, std::vector<dof_id_type>>::const_iterator
+      ids_it = requested_objs_id.find(pid);
+    libmesh_assert(ids_it != requested_objs_id.end());
+    libmesh_assert_equal_to (ids_it->second.size(), data.size());
+
+    // Let the user process the results
+    sync.act_on_data(ids_it->second, data);
+  }
+
+  const std::map<processor_id_type, std::vector<dof_id_type>> & requested_objs_id;
+  SyncFunctor & sync;
+};
+
+
+// As above, for a SyncFunctor whose act_on_data() reports whether
+// any of the results were different than what it expected
+template <typename SyncFunctor>
+struct SyncActOnChangedData
+{
+  SyncActOnChangedData(const std::map<processor_id_type, std::vector<dof_id_type>> & ids,
+                       SyncFunctor & s) :
+    requested_objs_id(ids), sync(s), data_changed(false) {}
+
+  template <typename QueryVector>
+  void operator() (processor_id_type pid,
+                   const QueryVector &,
+                   std::vector<typename SyncFunctor::datum> & data)
+  {
+    std::map<processor_id_type, std::vector<dof_id_type>>::const_iterator
+      ids_it = requested_objs_id.find(pid);
+    libmesh_assert(ids_it != requested_objs_id.end());
+    libmesh_assert_equal_to (ids_it->second.size(), data.size());
+
+    if (sync.act_on_data(ids_it->second, data))
+      data_changed = true;
+  }
+
+  const std::map<processor_id_type, std::vector<dof_id_type>> & requested_objs_id;
+  SyncFunctor & sync;
+  bool data_changed;
+};
+
+
+
 template <typename Iterator,
           typename DofObjType,
           typename SyncFunctor>
@@ -204,22 +388,18 @@ void sync_dofobject_data_by_xyz(const Communicator & comm,
     }
 
   // Request sets to send to each processor
-  std::vector<std::vector<Real>>
-    requested_objs_x(comm.size()),
-    requested_objs_y(comm.size()),
-    requested_objs_z(comm.size());
+  std::map<processor_id_type, std::vector<Point>>
+    requested_objs_pt;
   // Corresponding ids to keep track of
-  std::vector<std::vector<dof_id_type>>
-    requested_objs_id(comm.size());
+  std::map<processor_id_type, std::vector<dof_id_type>>
+    requested_objs_id;
 
   // We know how many objects live on each processor, so reserve()
   // space for each.
   for (processor_id_type p=0; p != comm.size(); ++p)
-    if (p != comm.rank())
+    if (p != comm.rank() && ghost_objects_from_proc[p])
       {
-        requested_objs_x[p].reserve(ghost_objects_from_proc[p]);
-        requested_objs_y[p].reserve(ghost_objects_from_proc[p]);
-        requested_objs_z[p].reserve(ghost_objects_from_proc[p]);
+        requested_objs_pt[p].reserve(ghost_objects_from_proc[p]);
         requested_objs_id[p].reserve(ghost_objects_from_proc[p]);
       }
   for (Iterator it = range_begin; it != range_end; ++it)
@@ -230,67 +410,16 @@ void sync_dofobject_data_by_xyz(const Communicator & comm,
           obj_procid == DofObject::invalid_processor_id)
         continue;
 
-      Point p = location_map.point_of(*obj);
-      requested_objs_x[obj_procid].push_back(p(0));
-      requested_objs_y[obj_procid].push_back(p(1));
-      requested_objs_z[obj_procid].push_back(p(2));
+      requested_objs_pt[obj_procid].push_back(location_map.point_of(*obj));
       requested_objs_id[obj_procid].push_back(obj->id());
     }
 
-  // Trade requests with other processors
-  for (processor_id_type p=1; p != comm.size(); ++p)
-    {
-      // Trade my requests with processor procup and procdown
-      const processor_id_type procup =
-        cast_int<processor_id_type>
-        ((comm.rank() + p) % comm.size());
-      const processor_id_type procdown =
-        cast_int<processor_id_type>
-        ((comm.size() + comm.rank() - p) %
-         comm.size());
-      std::vector<Real> request_to_fill_x,
-        request_to_fill_y,
-        request_to_fill_z;
-      comm.send_receive(procup, requested_objs_x[procup],
-                        procdown, request_to_fill_x);
-      comm.send_receive(procup, requested_objs_y[procup],
-                        procdown, request_to_fill_y);
-      comm.send_receive(procup, requested_objs_z[procup],
-                        procdown, request_to_fill_z);
-
-      // Find the local id of each requested object
-      std::vector<dof_id_type> request_to_fill_id(request_to_fill_x.size());
-      for (std::size_t i=0; i != request_to_fill_x.size(); ++i)
-        {
-          Point pt(request_to_fill_x[i],
-                   request_to_fill_y[i],
-                   request_to_fill_z[i]);
-
-          // Look for this object in the multimap
-          DofObjType * obj = location_map.find(pt);
-
-          // We'd better find every object we're asked for
-          libmesh_assert (obj);
-
-          // Return the object's correct processor id,
-          // and our (correct if it's local) id for it.
-          request_to_fill_id[i] = obj->id();
-        }
-
-      // Gather whatever data the user wants
-      std::vector<typename SyncFunctor::datum> data;
-      sync.gather_data(request_to_fill_id, data);
-
-      // Trade back the results
-      std::vector<typename SyncFunctor::datum> received_data;
-      comm.send_receive(procdown, data,
-                        procup, received_data);
-      libmesh_assert_equal_to (requested_objs_x[procup].size(),
-                               received_data.size());
-
-      // Let the user process the results
-      sync.act_on_data(requested_objs_id[procup], received_data);
-    }
+  // Trade requests with only those processors we need to hear from
+  SyncGatherByXyz<DofObjType, SyncFunctor> gather_data(location_map, sync);
+  SyncActOnData<SyncFunctor> act_on_data(requested_objs_id, sync);
+  typename SyncFunctor::datum * ex = libmesh_nullptr;
+  pull_parallel_vector_data
+    (comm, requested_objs_pt, gather_data, act_on_data, ex);
 }
 
 
@@ -337,13 +466,13 @@ void sync_dofobject_data_by_id(const Communicator & comm,
     }
 
   // Request sets to send to each processor
-  std::vector<std::vector<dof_id_type>>
-    requested_objs_id(comm.size());
+  std::map<processor_id_type, std::vector<dof_id_type>>
+    requested_objs_id;
 
   // We know how many objects live on each processor, so reserve()
   // space for each.
   for (processor_id_type p=0; p != comm.size(); ++p)
-    if (p != comm.rank())
+    if (p != comm.rank() && ghost_objects_from_proc[p])
       {
         requested_objs_id[p].reserve(ghost_objects_from_proc[p]);
       }
@@ -362,35 +491,12 @@ void sync_dofobject_data_by_id(const Communicator & comm,
       requested_objs_id[obj_procid].push_back(obj->id());
     }
 
-  // Trade requests with other processors
-  for (processor_id_type p=1; p != comm.size(); ++p)
-    {
-      // Trade my requests with processor procup and procdown
-      const processor_id_type procup =
-        cast_int<processor_id_type>
-        ((comm.rank() + p) % comm.size());
-      const processor_id_type procdown =
-        cast_int<processor_id_type>
-        ((comm.size() + comm.rank() - p) %
-         comm.size());
-      std::vector<dof_id_type> request_to_fill_id;
-      comm.send_receive(procup, requested_objs_id[procup],
-                        procdown, request_to_fill_id);
-
-      // Gather whatever data the user wants
-      std::vector<typename SyncFunctor::datum> data;
-      sync.gather_data(request_to_fill_id, data);
-
-      // Trade back the results
-      std::vector<typename SyncFunctor::datum> received_data;
-      comm.send_receive(procdown, data,
-                        procup, received_data);
-      libmesh_assert_equal_to (requested_objs_id[procup].size(),
-                               received_data.size());
-
-      // Let the user process the results
-      sync.act_on_data(requested_objs_id[procup], received_data);
-    }
+  // Trade requests with only those processors we need to hear from
+  SyncGatherById<SyncFunctor> gather_data(sync);
+  SyncActOnData<SyncFunctor> act_on_data(requested_objs_id, sync);
+  typename SyncFunctor::datum * ex = libmesh_nullptr;
+  pull_parallel_vector_data
+    (comm, requested_objs_id, gather_data, act_on_data, ex);
 }
 
 
@@ -422,21 +528,21 @@ void sync_element_data_by_parent_id(MeshBase &       mesh,
         ghost_objects_from_proc[obj_procid]++;
     }
 
-  // Request sets to send to each processor
-  std::vector<std::vector<dof_id_type>>
-    requested_objs_id(comm.size()),
-    requested_objs_parent_id(comm.size());
-  std::vector<std::vector<unsigned char>>
-    requested_objs_child_num(comm.size());
+  // Request sets to send to each processor: the parent id and child
+  // number of each element
+  std::map<processor_id_type, std::vector<std::pair<dof_id_type, unsigned char>>>
+    requested_objs_child;
+  // Corresponding ids to keep track of
+  std::map<processor_id_type, std::vector<dof_id_type>>
+    requested_objs_id;
 
   // We know how many objects live on each processor, so reserve()
   // space for each.
   for (processor_id_type p=0; p != comm.size(); ++p)
-    if (p != comm.rank())
+    if (p != comm.rank() && ghost_objects_from_proc[p])
       {
         requested_objs_id[p].reserve(ghost_objects_from_proc[p]);
-        requested_objs_parent_id[p].reserve(ghost_objects_from_proc[p]);
-        requested_objs_child_num[p].reserve(ghost_objects_from_proc[p]);
+        requested_objs_child[p].reserve(ghost_objects_from_proc[p]);
       }
 
   for (Iterator it = range_begin; it != range_end; ++it)
@@ -451,57 +557,31 @@ void sync_element_data_by_parent_id(MeshBase &       mesh,
         continue;
 
       requested_objs_id[obj_procid].push_back(elem->id());
-      requested_objs_parent_id[obj_procid].push_back(parent->id());
-      requested_objs_child_num[obj_procid].push_back
-        (cast_int<unsigned char>
-         (parent->which_child_am_i(elem)));
+      requested_objs_child[obj_procid].push_back
+        (std::make_pair
+         (parent->id(),
+          cast_int<unsigned char>
+          (parent->which_child_am_i(elem))));
     }
 
-  // Trade requests with other processors
-  for (processor_id_type p=1; p != comm.size(); ++p)
-    {
-      // Trade my requests with processor procup and procdown
-      const processor_id_type procup =
-        cast_int<processor_id_type>
-        ((comm.rank() + p) % comm.size());
-      const processor_id_type procdown =
-        cast_int<processor_id_type>
-        ((comm.size() + comm.rank() - p) %
-         comm.size());
-      std::vector<dof_id_type>   request_to_fill_parent_id;
-      std::vector<unsigned char> request_to_fill_child_num;
-      comm.send_receive(procup, requested_objs_parent_id[procup],
-                        procdown, request_to_fill_parent_id);
-      comm.send_receive(procup, requested_objs_child_num[procup],
-                        procdown, request_to_fill_child_num);
-
-      // Find the id of each requested element
-      std::size_t request_size = request_to_fill_parent_id.size();
-      std::vector<dof_id_type> request_to_fill_id(request_size);
-      for (std::size_t i=0; i != request_size; ++i)
-        {
-          Elem & parent = mesh.elem_ref(request_to_fill_parent_id[i]);
-          libmesh_assert(parent.has_children());
-          Elem * child = parent.child_ptr(request_to_fill_child_num[i]);
-          libmesh_assert(child);
-          libmesh_assert(child->active());
-          request_to_fill_id[i] = child->id();
-        }
-
-      // Gather whatever data the user wants
-      std::vector<typename SyncFunctor::datum> data;
-      sync.gather_data(request_to_fill_id, data);
-
-      // Trade back the results
-      std::vector<typename SyncFunctor::datum> received_data;
-      comm.send_receive(procdown, data,
-                        procup, received_data);
-      libmesh_assert_equal_to (requested_objs_id[procup].size(),
-                               received_data.size());
-
-      // Let the user process the results
-      sync.act_on_data(requested_objs_id[procup], received_data);
-    }
+  // We may have reserved space for processors we ended up with
+  // nothing to ask; don't bother them.
+  for (auto it = requested_objs_child.begin();
+       it != requested_objs_child.end();)
+    if (it->second.empty())
+      {
+        requested_objs_id.erase(it->first);
+        requested_objs_child.erase(it++);
+      }
+    else
+      ++it;
+
+  // Trade requests with only those processors we need to hear from
+  SyncGatherByParentId<SyncFunctor> gather_data(mesh, sync);
+  SyncActOnData<SyncFunctor> act_on_data(requested_objs_id, sync);
+  typename SyncFunctor::datum * ex = libmesh_nullptr;
+  pull_parallel_vector_data
+    (comm, requested_objs_child, gather_data, act_on_data, ex);
 }
 #else
 template <typename Iterator,
@@ -580,23 +660,21 @@ void sync_node_data_by_element_id(MeshBase &       mesh,
 
       // Now repeat that iteration, filling request sets this time.
 
-      // Request sets to send to each processor
-      std::vector<std::vector<dof_id_type>>
-        requested_objs_elem_id(comm.size());
-      std::vector<std::vector<unsigned char>>
-        requested_objs_node_num(comm.size());
+      // Request sets to send to each processor: the element id and
+      // local node number of each node
+      std::map<processor_id_type, std::vector<std::pair<dof_id_type, unsigned char>>>
+        requested_objs_elem_node;
 
       // Keep track of current local ids for each too
-      std::vector<std::vector<dof_id_type>>
-        requested_objs_id(comm.size());
+      std::map<processor_id_type, std::vector<dof_id_type>>
+        requested_objs_id;
 
       // We know how many objects live on each processor, so reserve()
       // space for each.
       for (processor_id_type p=0; p != comm.size(); ++p)
-        if (p != comm.rank())
+        if (p != comm.rank() && ghost_objects_from_proc[p])
           {
-            requested_objs_elem_id[p].reserve(ghost_objects_from_proc[p]);
-            requested_objs_node_num[p].reserve(ghost_objects_from_proc[p]);
+            requested_objs_elem_node[p].reserve(ghost_objects_from_proc[p]);
             requested_objs_id[p].reserve(ghost_objects_from_proc[p]);
           }
 
@@ -624,79 +702,36 @@ void sync_node_data_by_element_id(MeshBase &       mesh,
               const Node & node = elem->node_ref(n);
               const dof_id_type node_id = node.id();
 
-              requested_objs_elem_id[proc_id].push_back(elem_id);
-              requested_objs_node_num[proc_id].push_back
-                (cast_int<unsigned char>(n));
+              requested_objs_elem_node[proc_id].push_back
+                (std::make_pair(elem_id, cast_int<unsigned char>(n)));
               requested_objs_id[proc_id].push_back(node_id);
             }
         }
 
-      // Trade requests with other processors
-      for (processor_id_type p=1; p != comm.size(); ++p)
-        {
-          // Trade my requests with processor procup and procdown
-          const processor_id_type procup =
-            cast_int<processor_id_type>
-            ((comm.rank() + p) % comm.size());
-          const processor_id_type procdown =
-            cast_int<processor_id_type>
-            ((comm.size() + comm.rank() - p) %
-             comm.size());
-
-          libmesh_assert_equal_to (requested_objs_id[procup].size(),
-                                   ghost_objects_from_proc[procup]);
-          libmesh_assert_equal_to (requested_objs_elem_id[procup].size(),
-                                   ghost_objects_from_proc[procup]);
-          libmesh_assert_equal_to (requested_objs_node_num[procup].size(),
-                                   ghost_objects_from_proc[procup]);
-
-          std::vector<dof_id_type>   request_to_fill_elem_id;
-          std::vector<unsigned char> request_to_fill_node_num;
-          comm.send_receive(procup, requested_objs_elem_id[procup],
-                            procdown, request_to_fill_elem_id);
-          comm.send_receive(procup, requested_objs_node_num[procup],
-                            procdown, request_to_fill_node_num);
-
-          // Find the id of each requested element
-          std::size_t request_size = request_to_fill_elem_id.size();
-          std::vector<dof_id_type> request_to_fill_id(request_size);
-          for (std::size_t i=0; i != request_size; ++i)
-            {
-              const Elem & elem = mesh.elem_ref(request_to_fill_elem_id[i]);
-
-              const unsigned int n = request_to_fill_node_num[i];
-              libmesh_assert_less (n, elem.n_nodes());
-
-              const Node & node = elem.node_ref(n);
+#ifndef NDEBUG
+      for (processor_id_type p=0; p != comm.size(); ++p)
+        if (ghost_objects_from_proc[p])
+          {
+            libmesh_assert_equal_to (requested_objs_id[p].size(),
+                                     ghost_objects_from_proc[p]);
+            libmesh_assert_equal_to (requested_objs_elem_node[p].size(),
+                                     ghost_objects_from_proc[p]);
+          }
+#endif
 
-              // This isn't a safe assertion in the case where we're
-              // syncing processor ids
-              // libmesh_assert_equal_to (node->processor_id(), comm.rank());
+      // Trade requests with only those processors we need to hear
+      // from.  If any of the results were different than what the
+      // user expected, then we'll need to sync again just in case
+      // this processor has to pass on the changes to yet another
+      // processor.
+      SyncGatherByElementId<SyncFunctor> gather_data(mesh, sync);
+      SyncActOnChangedData<SyncFunctor> act_on_data(requested_objs_id, sync);
+      typename SyncFunctor::datum * ex = libmesh_nullptr;
+      pull_parallel_vector_data
+        (comm, requested_objs_elem_node, gather_data, act_on_data, ex);
 
-              request_to_fill_id[i] = node.id();
-            }
+      need_sync = act_on_data.data_changed;
 
-          // Gather whatever data the user wants
-          std::vector<typename SyncFunctor::datum> data;
-          sync.gather_data(request_to_fill_id, data);
-
-          // Trade back the results
-          std::vector<typename SyncFunctor::datum> received_data;
-          comm.send_receive(procdown, data,
-                            procup, received_data);
-          libmesh_assert_equal_to (requested_objs_elem_id[procup].size(),
-                                   received_data.size());
-
-          // Let the user process the results.  If any of the results
-          // were different than what the user expected, then we'll
-          // need to sync again just in case this processor has to
-          // pass on the changes to yet another processor.
-          bool data_changed =
-            sync.act_on_data(requested_objs_id[procup], received_data);
-
-          if (data_changed)
-            need_sync = true;
-        }
       comm.max(need_sync);
     } while (need_sync);
 }
@@ -622,6 +622,7 @@ inline Communicator::Communicator () :
   _size(1),
   _send_mode(DEFAULT),
   used_tag_values(),
+  _next_tag_value(first_cycled_tag),
   _I_duped_it(false) {}
 
 inline Communicator::Communicator (const communicator & comm) :
@@ -632,6 +633,7 @@ inline Communicator::Communicator (const communicator & comm) :
   _size(1),
   _send_mode(DEFAULT),
   used_tag_values(),
+  _next_tag_value(first_cycled_tag),
   _I_duped_it(false)
 {
   this->assign(comm);
@@ -713,6 +715,7 @@ inline Communicator::Communicator (const Communicator &) :
   _size(1),
   _send_mode(DEFAULT),
   used_tag_values(),
+  _next_tag_value(first_cycled_tag),
   _I_duped_it(false)
 {
   libmesh_not_implemented();
@@ -1368,6 +1371,18 @@ MessageTag Communicator::get_unique_tag(int tagvalue) const
 }
 
 
+inline
+MessageTag Communicator::get_unique_tag() const
+{
+  const int tagvalue = _next_tag_value;
+
+  if (++_next_tag_value == end_cycled_tag)
+    _next_tag_value = first_cycled_tag;
+
+  return this->get_unique_tag(tagvalue);
+}
+
+
 inline
 void Communicator::reference_unique_tag(int tagvalue) const
 {
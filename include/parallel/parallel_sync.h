@@ -0,0 +1,516 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_PARALLEL_SYNC_H
+#define LIBMESH_PARALLEL_SYNC_H
+
+// Local Includes
+#include "libmesh/libmesh_logging.h"
+#include "libmesh/parallel.h"
+
+// C++ includes
+#include <map>
+#include <vector>
+
+
+namespace libMesh
+{
+
+
+
+//--------------------------------------------------------------------------
+namespace Parallel {
+
+//------------------------------------------------------------------------
+/**
+ * Send and receive a vector of data to and from each processor which
+ * we have data for, without communicating with any other processors.
+ *
+ * \p data is a map (e.g. \p std::map<processor_id_type,
+ * std::vector<T>>) from destination processor ids to the vectors to
+ * send them.  Each processor calls
+ * act_on_data(processor_id_type pid, std::vector<T> & received)
+ * once for every vector which was sent to it, in the order the
+ * messages arrive.  The user must define Parallel::StandardType<T>
+ * if T isn't a built-in type; vectors of such vectors may be sent as
+ * well.
+ *
+ * No processor needs to know in advance which processors will send
+ * it data.  Messages are sent with nonblocking synchronous sends,
+ * and once all of a processor's sends have been matched it enters a
+ * nonblocking barrier while it continues to receive; when that
+ * barrier completes, every message has been received everywhere.
+ * The cost is thus proportional to the number of communicating
+ * neighbors rather than to the number of processors.
+ */
+template <typename MapToVectors,
+          typename ActionFunctor>
+void push_parallel_vector_data(const Communicator & comm,
+                               const MapToVectors & data,
+                               ActionFunctor &      act_on_data);
+
+//------------------------------------------------------------------------
+/**
+ * Send query vectors, receive and answer them with vectors of data,
+ * and then receive and act on the answers, without communicating
+ * with processors which we have no queries for or which have no
+ * queries for us.
+ *
+ * \p queries is a map (e.g. \p std::map<processor_id_type,
+ * std::vector<Q>>) from destination processor ids to the queries to
+ * send them.  Queries are answered with
+ * gather_data(processor_id_type pid,
+ *             const std::vector<Q> & query,
+ *             std::vector<datum> & response),
+ * by resizing and setting the values of the response vector.
+ * Responses are handled with
+ * act_on_data(processor_id_type pid,
+ *             const std::vector<Q> & query,
+ *             std::vector<datum> & response)
+ * The \p example pointer is unused, and only serves to indicate the
+ * response \p datum type.  Both exchanges are done with \p
+ * push_parallel_vector_data().
+ */
+template <typename datum,
+          typename MapToVectors,
+          typename GatherFunctor,
+          typename ActionFunctor>
+void pull_parallel_vector_data(const Communicator & comm,
+                               const MapToVectors & queries,
+                               GatherFunctor &      gather_data,
+                               ActionFunctor &      act_on_data,
+                               const datum *        example);
+
+//------------------------------------------------------------------------
+/**
+ * A sparse exchange of vectors of data, for callers which want to
+ * start sending each vector as soon as it is ready rather than
+ * building them all first.  This is what \p
+ * push_parallel_vector_data() uses internally.
+ *
+ * Every processor in the communicator must construct the exchange,
+ * \p send() any number of vectors to other processors, and then call
+ * \p receive(), which hands each vector sent to this processor to
+ * act_on_data(processor_id_type pid, Container & received)
+ * in the order the messages arrive, and which returns once every
+ * vector has been received everywhere.  Each exchange uses its own
+ * message tag, so several may be in progress at once.
+ */
+template <typename Container>
+class SparseExchange
+{
+public:
+  /**
+   * Constructor.  Must be called on all processors at once.
+   */
+  explicit
+  SparseExchange (const Communicator & comm);
+
+  /**
+   * Starts sending \p data to processor \p pid, which must not be
+   * this processor.  If \p Container is a plain vector, \p data is
+   * sent in place and must not be modified or destroyed until \p
+   * receive() has returned; vectors of vectors are copied first.
+   */
+  void send (processor_id_type pid,
+             const Container & data);
+
+  /**
+   * Receives and acts on the vectors sent to this processor, until
+   * all processors' sends have been received.
+   */
+  template <typename ActionFunctor>
+  void receive (ActionFunctor & act_on_data);
+
+private:
+  const Communicator & _communicator;
+
+  MessageTag _tag;
+
+  std::vector<Request> _send_requests;
+
+  /**
+   * The processors we have sent to, which we only need to know about
+   * if there is no nonblocking barrier with which to detect the end
+   * of the exchange.
+   */
+  std::vector<processor_id_type> _destinations;
+};
+
+} // namespace Parallel
+
+} // namespace libMesh
+
+
+
+// Anonymous namespace for helper functions
+namespace {
+
+#ifdef LIBMESH_HAVE_MPI
+// Nonblocking synchronous send of a vector.  We don't use
+// Communicator::send(), which would only use a synchronous send
+// depending on the Communicator's send mode; our termination
+// detection relies on knowing when each message has been matched.
+template <typename T>
+inline void sparse_exchange_send(const libMesh::Parallel::Communicator & comm,
+                                 const libMesh::processor_id_type dest_processor_id,
+                                 const std::vector<T> & buf,
+                                 libMesh::Parallel::Request & req,
+                                 const libMesh::Parallel::MessageTag & tag)
+{
+  T * dataptr = buf.empty() ? libmesh_nullptr : const_cast<T *>(&buf[0]);
+
+  libmesh_call_mpi
+    (MPI_Issend (dataptr,
+                 libMesh::cast_int<int>(buf.size()),
+                 libMesh::Parallel::StandardType<T>(dataptr),
+                 dest_processor_id,
+                 tag.value(),
+                 comm.get(),
+                 req.get()));
+}
+
+
+
+// A vector of vectors is sent as two messages: the inner vector
+// sizes followed by their concatenated contents.  MPI guarantees
+// that messages with the same source and tag arrive in order.
+template <typename T>
+inline void sparse_exchange_send(const libMesh::Parallel::Communicator & comm,
+                                 const libMesh::processor_id_type dest_processor_id,
+                                 const std::vector<std::vector<T>> & buf,
+                                 libMesh::Parallel::Request & req,
+                                 const libMesh::Parallel::MessageTag & tag)
+{
+  // Allocate temporary buffers on the heap so they live until after
+  // the non-blocking sends complete
+  std::vector<unsigned int> * sizes =
+    new std::vector<unsigned int>(buf.size());
+  std::vector<T> * contents = new std::vector<T>;
+
+  std::size_t total_size = 0;
+  for (std::size_t i=0; i != buf.size(); ++i)
+    {
+      (*sizes)[i] = libMesh::cast_int<unsigned int>(buf[i].size());
+      total_size += buf[i].size();
+    }
+
+  contents->reserve(total_size);
+  for (std::size_t i=0; i != buf.size(); ++i)
+    contents->insert(contents->end(), buf[i].begin(), buf[i].end());
+
+  libMesh::Parallel::Request sizes_req;
+  sizes_req.add_post_wait_work
+    (new libMesh::Parallel::PostWaitDeleteBuffer<std::vector<unsigned int>>(sizes));
+  sparse_exchange_send(comm, dest_processor_id, *sizes, sizes_req, tag);
+
+  // Make the Request::wait() handle deleting the buffers
+  req.add_post_wait_work
+    (new libMesh::Parallel::PostWaitDeleteBuffer<std::vector<T>>(contents));
+  sparse_exchange_send(comm, dest_processor_id, *contents, req, tag);
+
+  // And don't finish up the full request until we're done with its
+  // dependencies.  Testing \p req alone is enough to tell that both
+  // messages have been matched, since the receiver must match the
+  // sizes before the contents.
+  req.add_prior_request(sizes_req);
+}
+
+
+
+template <typename T>
+inline void sparse_exchange_receive(const libMesh::Parallel::Communicator & comm,
+                                    const libMesh::processor_id_type src_processor_id,
+                                    std::vector<T> & buf,
+                                    const libMesh::Parallel::MessageTag & tag)
+{
+  comm.receive(src_processor_id, buf, tag);
+}
+
+
+
+template <typename T>
+inline void sparse_exchange_receive(const libMesh::Parallel::Communicator & comm,
+                                    const libMesh::processor_id_type src_processor_id,
+                                    std::vector<std::vector<T>> & buf,
+                                    const libMesh::Parallel::MessageTag & tag)
+{
+  std::vector<unsigned int> sizes;
+  std::vector<T> contents;
+  comm.receive(src_processor_id, sizes, tag);
+  comm.receive(src_processor_id, contents, tag);
+
+  buf.resize(sizes.size());
+  typename std::vector<T>::const_iterator it = contents.begin();
+  for (std::size_t i=0; i != sizes.size(); ++i)
+    {
+      buf[i].assign(it, it + sizes[i]);
+      it += sizes[i];
+    }
+  libmesh_assert(it == contents.end());
+}
+#endif // LIBMESH_HAVE_MPI
+
+
+
+// Answers each query as it is received, saving the response to
+// send back later
+template <typename datum, typename GatherFunctor>
+struct SparseExchangeGather
+{
+  SparseExchangeGather(GatherFunctor & g,
+                       std::map<libMesh::processor_id_type, std::vector<datum>> & r) :
+    gather_data(g), responses(r) {}
+
+  template <typename QueryVector>
+  void operator() (libMesh::processor_id_type pid, QueryVector & query)
+  {
+    std::vector<datum> & response = responses[pid];
+    gather_data(pid, const_cast<const QueryVector &>(query), response);
+    libmesh_assert_equal_to(query.size(), response.size());
+  }
+
+  GatherFunctor & gather_data;
+  std::map<libMesh::processor_id_type, std::vector<datum>> & responses;
+};
+
+
+
+// Hands each response to the user along with the query it answers
+template <typename MapToVectors, typename ActionFunctor>
+struct SparseExchangeAct
+{
+  SparseExchangeAct(const MapToVectors & q, ActionFunctor & a) :
+    queries(q), act_on_data(a) {}
+
+  template <typename ResponseVector>
+  void operator() (libMesh::processor_id_type pid, ResponseVector & response)
+  {
+    typename MapToVectors::const_iterator query_it = queries.find(pid);
+    libmesh_assert(query_it != queries.end());
+    libmesh_assert_equal_to(query_it->second.size(), response.size());
+    act_on_data(pid, query_it->second, response);
+  }
+
+  const MapToVectors & queries;
+  ActionFunctor & act_on_data;
+};
+
+}
+
+
+
+namespace libMesh
+{
+
+namespace Parallel {
+
+template <typename Container>
+inline
+SparseExchange<Container>::SparseExchange (const Communicator & comm) :
+  _communicator(comm),
+  // Processors which leave one exchange early may start sending the
+  // next while others are still receiving, so each exchange needs a
+  // different tag than the last
+  _tag(comm.get_unique_tag())
+{
+  // The tag must be taken on all processors at once
+  libmesh_parallel_only(comm);
+}
+
+
+
+template <typename Container>
+inline
+void SparseExchange<Container>::send (processor_id_type pid,
+                                      const Container & data)
+{
+  libmesh_assert_less (pid, _communicator.size());
+  libmesh_assert_not_equal_to (pid, _communicator.rank());
+
+#ifdef LIBMESH_HAVE_MPI
+  _send_requests.push_back(Request());
+  _destinations.push_back(pid);
+  sparse_exchange_send(_communicator, pid, data,
+                       _send_requests.back(), _tag);
+#else
+  libmesh_ignore(data);
+#endif
+}
+
+
+
+template <typename Container>
+template <typename ActionFunctor>
+inline
+void SparseExchange<Container>::receive (ActionFunctor & act_on_data)
+{
+  // This function must be run on all processors at once
+  libmesh_parallel_only(_communicator);
+
+#ifdef LIBMESH_HAVE_MPI
+  if (_communicator.size() == 1)
+    return;
+
+  const Communicator & comm = _communicator;
+
+#if MPI_VERSION > 2
+  // Receive messages until all of ours have been received and every
+  // other processor has said the same.
+  std::size_t n_sends_complete = 0;
+  Request barrier_request;
+  bool barrier_started = false;
+
+  while (true)
+    {
+      Status stat;
+      int flag = 0;
+      libmesh_call_mpi
+        (MPI_Iprobe (any_source, _tag.value(), comm.get(),
+                     &flag, stat.get()));
+
+      if (flag)
+        {
+          const processor_id_type pid =
+            cast_int<processor_id_type>(stat.source());
+          Container received;
+          sparse_exchange_receive(comm, pid, received, _tag);
+          act_on_data(pid, received);
+          continue;
+        }
+
+      if (barrier_started)
+        {
+          if (barrier_request.test())
+            break;
+        }
+      else
+        {
+          while (n_sends_complete != _send_requests.size() &&
+                 _send_requests[n_sends_complete].test())
+            ++n_sends_complete;
+
+          if (n_sends_complete == _send_requests.size())
+            {
+              libmesh_call_mpi
+                (MPI_Ibarrier (comm.get(), barrier_request.get()));
+              barrier_started = true;
+            }
+        }
+    }
+#else
+  // Without a nonblocking barrier we need to find out how many
+  // messages to expect.
+  std::vector<unsigned int> n_incoming(comm.size(), 0);
+  for (std::size_t i=0; i != _destinations.size(); ++i)
+    n_incoming[_destinations[i]] = 1;
+  comm.sum(n_incoming);
+
+  for (unsigned int i=0; i != n_incoming[comm.rank()]; ++i)
+    {
+      Status stat(comm.probe(any_source, _tag));
+      const processor_id_type pid =
+        cast_int<processor_id_type>(stat.source());
+      Container received;
+      sparse_exchange_receive(comm, pid, received, _tag);
+      act_on_data(pid, received);
+    }
+#endif // MPI_VERSION > 2
+
+  // Our sends are all complete; this frees their buffers
+  Parallel::wait(_send_requests);
+  _send_requests.clear();
+  _destinations.clear();
+#else
+  libmesh_ignore(act_on_data);
+#endif // LIBMESH_HAVE_MPI
+}
+
+
+
+template <typename MapToVectors,
+          typename ActionFunctor>
+void push_parallel_vector_data(const Communicator & comm,
+                               const MapToVectors & data,
+                               ActionFunctor &      act_on_data)
+{
+  // This function must be run on all processors at once
+  libmesh_parallel_only(comm);
+
+  typedef typename MapToVectors::mapped_type container_type;
+
+  LOG_SCOPE("push_parallel_vector_data()", "Parallel");
+
+  const processor_id_type my_pid = comm.rank();
+
+  SparseExchange<container_type> exchange(comm);
+
+  // Post all our sends
+  typename MapToVectors::const_iterator my_data = data.end();
+
+  for (typename MapToVectors::const_iterator it = data.begin();
+       it != data.end(); ++it)
+    {
+      libmesh_assert_less (it->first, comm.size());
+
+      if (it->first == my_pid)
+        my_data = it;
+      else
+        exchange.send(it->first, it->second);
+    }
+
+  // Handle our own data while the messages are in flight
+  if (my_data != data.end())
+    {
+      container_type my_copy = my_data->second;
+      act_on_data(my_pid, my_copy);
+    }
+
+  exchange.receive(act_on_data);
+}
+
+
+
+template <typename datum,
+          typename MapToVectors,
+          typename GatherFunctor,
+          typename ActionFunctor>
+void pull_parallel_vector_data(const Communicator & comm,
+                               const MapToVectors & queries,
+                               GatherFunctor &      gather_data,
+                               ActionFunctor &      act_on_data,
+                               const datum *)
+{
+  // This function must be run on all processors at once
+  libmesh_parallel_only(comm);
+
+  std::map<processor_id_type, std::vector<datum>> responses;
+
+  SparseExchangeGather<datum, GatherFunctor> gather(gather_data, responses);
+  push_parallel_vector_data(comm, queries, gather);
+
+  SparseExchangeAct<MapToVectors, ActionFunctor> act(queries, act_on_data);
+  push_parallel_vector_data(comm, responses, act);
+}
+
+} // namespace Parallel
+
+} // namespace libMesh
+
+#endif // LIBMESH_PARALLEL_SYNC_H
@@ -168,6 +168,18 @@ public:
     _grainsize(r._grainsize)
   {}
 
+  /**
+   * Constructor.  Takes an existing \p BlockedRange and the
+   * beginning and end of a subrange of it.
+   */
+  BlockedRange (const BlockedRange<T> & r,
+                const const_iterator first,
+                const const_iterator last) :
+    _grainsize(r._grainsize)
+  {
+    this->reset(first, last);
+  }
+
   /**
    * Splits the range \p r.  The first half
    * of the range is left in place, the second
@@ -220,7 +232,7 @@ public:
   /**
    * \returns The size of the range.
    */
-  int size () const { return (_end -_begin); }
+  std::size_t size () const { return (_end -_begin); }
 
   //------------------------------------------------------------------------
   // Methods that implement Range concept
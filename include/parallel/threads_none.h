@@ -130,6 +130,7 @@ public:
   spin_mutex() {}
   void lock () {}
   void unlock () {}
+  bool try_lock () { return true; }
 
   class scoped_lock
   {
@@ -137,6 +138,7 @@ public:
     scoped_lock () {}
     explicit scoped_lock ( spin_mutex &  ) {}
     void acquire ( spin_mutex & ) {}
+    bool try_acquire ( spin_mutex & ) { return true; }
     void release () {}
   };
 };
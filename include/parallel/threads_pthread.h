@@ -34,6 +34,8 @@
 #include "libmesh/libmesh_logging.h"
 #include <pthread.h>
 #include <algorithm>
+#include <iterator>
+#include <memory>
 #include <vector>
 
 #ifdef __APPLE__
@@ -90,6 +92,7 @@ public:
 
   void lock () { os_unfair_lock_lock(&ulock); }
   void unlock () { os_unfair_lock_unlock(&ulock); }
+  bool try_lock () { return os_unfair_lock_trylock(&ulock); }
 
   class scoped_lock
   {
@@ -100,6 +103,13 @@ public:
     ~scoped_lock () { release(); }
 
     void acquire ( spin_mutex & in_smutex ) { smutex = &in_smutex; smutex->lock(); }
+    bool try_acquire ( spin_mutex & in_smutex )
+    {
+      if (!in_smutex.try_lock())
+        return false;
+      smutex = &in_smutex;
+      return true;
+    }
     void release () { if (smutex) smutex->unlock(); smutex = libmesh_nullptr; }
 
   private:
@@ -118,6 +128,7 @@ public:
 
   void lock () { OSSpinLockLock(&slock); }
   void unlock () { OSSpinLockUnlock(&slock); }
+  bool try_lock () { return OSSpinLockTry(&slock); }
 
   class scoped_lock
   {
@@ -128,6 +139,13 @@ public:
     ~scoped_lock () { release(); }
 
     void acquire ( spin_mutex & in_smutex ) { smutex = &in_smutex; smutex->lock(); }
+    bool try_acquire ( spin_mutex & in_smutex )
+    {
+      if (!in_smutex.try_lock())
+        return false;
+      smutex = &in_smutex;
+      return true;
+    }
     void release () { if (smutex) smutex->unlock(); smutex = libmesh_nullptr; }
 
   private:
@@ -148,6 +166,7 @@ public:
 
   void lock () { pthread_spin_lock(&slock); }
   void unlock () { pthread_spin_unlock(&slock); }
+  bool try_lock () { return !pthread_spin_trylock(&slock); }
 
   class scoped_lock
   {
@@ -158,6 +177,13 @@ public:
     ~scoped_lock () { release(); }
 
     void acquire ( spin_mutex & in_smutex ) { smutex = &in_smutex; smutex->lock(); }
+    bool try_acquire ( spin_mutex & in_smutex )
+    {
+      if (!in_smutex.try_lock())
+        return false;
+      smutex = &in_smutex;
+      return true;
+    }
     void release () { if (smutex) smutex->unlock(); smutex = libmesh_nullptr; }
 
   private:
@@ -217,37 +243,275 @@ unsigned int num_pthreads(Range & range)
   return min > 0 ? min : 1;
 }
 
-template <typename Range, typename Body>
-class RangeBody
+
+
+/**
+ * Persistent pool of worker threads used to execute parallel_for()
+ * and parallel_reduce().  The workers are created once (by
+ * task_scheduler_init, which LibMeshInit constructs) and then sleep
+ * between parallel loops, rather than being spawned and joined on
+ * every call.
+ *
+ * Work is handed to the pool as a number of independent tasks.  Each
+ * participating thread (the calling thread is participant 0) starts
+ * out owning a contiguous block of task indices, which it consumes
+ * from the front.  A thread which runs out of work steals the back
+ * half of another thread's remaining block, so loops with uneven
+ * per-task cost (mixed element types or p-levels) stay balanced.
+ */
+class ThreadPool
 {
 public:
-  Range * range;
-  Body * body;
+  /**
+   * Signature of the functions executed by the pool.  \p task is the
+   * index of the task to be executed and \p thread the index of the
+   * participating thread executing it.
+   */
+  typedef void (*task_function) (void * context,
+                                 std::size_t task,
+                                 unsigned int thread);
+
+  /**
+   * \returns The process-wide pool.
+   */
+  static ThreadPool & instance ();
+
+  /**
+   * Destructor.  Joins any worker threads.
+   */
+  ~ThreadPool ();
+
+  /**
+   * Starts the worker threads so that \p n_threads threads (including
+   * the calling thread) can participate in parallel loops.  Any
+   * previously started workers are stopped first.
+   */
+  void initialize (unsigned int n_threads);
+
+  /**
+   * Stops and joins the worker threads.
+   */
+  void terminate ();
+
+  /**
+   * \returns The number of threads, including the calling thread,
+   * which can participate in a parallel loop.
+   */
+  unsigned int n_threads () const { return _n_threads; }
+
+  /**
+   * Executes \p f(context, i, thread) for every task index \p i in
+   * [0, n_tasks) using at most \p n_threads threads, and returns once
+   * all tasks are complete.  The pool is (re)started if it is too
+   * small for the request.  A loop run by a task of another loop, or
+   * started by another thread while a loop has the pool, executes all
+   * its tasks on the calling thread.
+   */
+  void run (std::size_t n_tasks,
+            task_function f,
+            void * context,
+            unsigned int n_threads);
+
+private:
+  ThreadPool ();
+
+  /**
+   * The block of task indices currently owned by a participating
+   * thread.
+   */
+  struct TaskBlock
+  {
+    TaskBlock () : begin(0), end(0) {}
+
+    spin_mutex mutex;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  /**
+   * Arguments handed to a newly created worker thread.  \p generation
+   * is the last loop the worker should consider already finished.
+   */
+  struct WorkerArgs
+  {
+    ThreadPool * pool;
+    unsigned int thread;
+    unsigned long generation;
+  };
+
+  static void * worker_main (void * args);
+
+  /**
+   * Sleeps until a new loop is started, participates in it if
+   * requested, and repeats until the pool is terminated.
+   */
+  void worker_loop (unsigned int thread, unsigned long seen_generation);
+
+  /**
+   * Executes tasks on \p thread until no work is left to claim.
+   */
+  void execute (unsigned int thread);
+
+  /**
+   * Claims the next task for \p thread, stealing from other threads'
+   * blocks if necessary.  \returns \p false if no tasks are left.
+   */
+  bool next_task (unsigned int thread, std::size_t & task);
+
+  /**
+   * Waits for all workers to finish the current loop.
+   */
+  void wait ();
+
+  /**
+   * Claims the pool for a loop, unless another loop already has it,
+   * and releases the claim when destroyed.  The flag is tested and
+   * set under a single lock, so that of two loops started at once
+   * only one gets the pool.
+   */
+  struct RunningFlag
+  {
+    RunningFlag (ThreadPool & pool) : _pool(pool)
+    {
+      pthread_mutex_lock(&_pool._mutex);
+      _acquired = !_pool._running;
+      _pool._running = true;
+      pthread_mutex_unlock(&_pool._mutex);
+    }
+
+    ~RunningFlag ()
+    {
+      if (!_acquired)
+        return;
+
+      pthread_mutex_lock(&_pool._mutex);
+      _pool._running = false;
+      pthread_mutex_unlock(&_pool._mutex);
+    }
+
+    /**
+     * \returns \p true if this flag claimed the pool.
+     */
+    bool acquired () const { return _acquired; }
+
+    ThreadPool & _pool;
+    bool _acquired;
+  };
+
+  std::vector<pthread_t> _workers;
+
+  std::unique_ptr<TaskBlock[]> _blocks;
+
+  pthread_mutex_t _mutex;
+  pthread_cond_t _wake;
+  pthread_cond_t _done;
+
+  unsigned long _generation;
+  bool _shutdown;
+  bool _running;
+
+  unsigned int _n_threads;
+  unsigned int _n_participants;
+  unsigned int _n_running;
+
+  task_function _function;
+  void * _context;
 };
 
+
+
+/**
+ * \returns The number of objects in each task when \p range is
+ * executed by \p n_threads threads.  The grain size of the range is
+ * respected as the largest chunk, but small ranges are cut finer so
+ * that every thread gets several chunks and work stealing can even
+ * out an imbalanced load.
+ */
+template <typename Range>
+std::size_t pthread_chunk_size (const Range & range,
+                                const unsigned int n_threads)
+{
+  const std::size_t
+    size = range.size(),
+    n_chunks = 4 * static_cast<std::size_t>(n_threads),
+    balanced_size = (size + n_chunks - 1) / n_chunks,
+    grain_size = range.grainsize();
+
+  return std::max(std::size_t(1), std::min(grain_size, balanced_size));
+}
+
+
+
+/**
+ * Task context for executing a Body on chunks of a Range from the
+ * ThreadPool.  parallel_for() shares a single const Body between all
+ * threads, while parallel_reduce() gives each chunk its own Body.
+ */
 template <typename Range, typename Body>
-void * run_body(void * args)
+class RangeTask
 {
-  RangeBody<Range, Body> * range_body = (RangeBody<Range, Body> *)args;
+public:
+  RangeTask (const Range & range_in,
+             std::size_t chunk_size_in) :
+    range(range_in),
+    chunk_size(chunk_size_in),
+    n_tasks((range_in.size() + chunk_size_in - 1) / chunk_size_in)
+  {}
+
+  /**
+   * \returns The subrange of objects belonging to task \p task.
+   */
+  Range * subrange (std::size_t task) const
+  {
+    const std::size_t
+      first = task * chunk_size,
+      last = std::min(first + chunk_size, static_cast<std::size_t>(range.size()));
 
-  Body & body = *range_body->body;
-  Range & range = *range_body->range;
+    return new Range(range, range.begin() + first, range.begin() + last);
+  }
 
-  body(range);
+  static void run_for (void * context, std::size_t task, unsigned int)
+  {
+    RangeTask<Range, Body> & range_task = *static_cast<RangeTask<Range, Body> *>(context);
 
-  return libmesh_nullptr;
-}
+    std::unique_ptr<Range> sub (range_task.subrange(task));
+
+    (*range_task.const_body)(*sub);
+  }
+
+  static void run_reduce (void * context, std::size_t task, unsigned int)
+  {
+    RangeTask<Range, Body> & range_task = *static_cast<RangeTask<Range, Body> *>(context);
+
+    std::unique_ptr<Range> sub (range_task.subrange(task));
+
+    (*range_task.bodies[task])(*sub);
+  }
+
+  const Range & range;
+  const std::size_t chunk_size;
+  const std::size_t n_tasks;
+
+  const Body * const_body;
+  std::vector<Body *> bodies;
+};
 
 /**
- * Scheduler to manage threads.
+ * Scheduler to manage threads.  Starts the persistent ThreadPool on
+ * construction and stops it on destruction.
  */
 class task_scheduler_init
 {
 public:
   static const int automatic = -1;
-  explicit task_scheduler_init (int = automatic) {}
-  void initialize (int = automatic) {}
-  void terminate () {}
+  explicit task_scheduler_init (int n_threads = automatic) { this->initialize(n_threads); }
+  ~task_scheduler_init () { this->terminate(); }
+  void initialize (int n_threads = automatic)
+  {
+    ThreadPool::instance().initialize
+      (n_threads == automatic ? libMesh::n_threads() : cast_int<unsigned int>(n_threads));
+  }
+  void terminate () { ThreadPool::instance().terminate(); }
 };
 
 //-------------------------------------------------------------------
@@ -280,66 +544,14 @@ void parallel_for (const Range & range, const Body & body)
 
   unsigned int n_threads = num_pthreads(range);
 
-  std::vector<Range *> ranges(n_threads);
-  std::vector<RangeBody<const Range, const Body>> range_bodies(n_threads);
-  std::vector<pthread_t> threads(n_threads);
-
-  // Create the ranges for each thread
-  unsigned int range_size = range.size() / n_threads;
-
-  typename Range::const_iterator current_beginning = range.begin();
-
-  for (unsigned int i=0; i<n_threads; i++)
-    {
-      unsigned int this_range_size = range_size;
-
-      if (i+1 == n_threads)
-        this_range_size += range.size() % n_threads; // Give the last one the remaining work to do
-
-      ranges[i] = new Range(range, current_beginning, current_beginning + this_range_size);
-
-      current_beginning = current_beginning + this_range_size;
-    }
-
-  // Create the RangeBody arguments
-  for (unsigned int i=0; i<n_threads; i++)
-    {
-      range_bodies[i].range = ranges[i];
-      range_bodies[i].body = &body;
-    }
-
-  // Create the threads.  It may seem redundant to wrap a pragma in
-  // #ifdefs... but GCC warns about an "unknown pragma" if it
-  // encounters this line of code when -fopenmp is not passed to the
-  // compiler.
-#ifdef LIBMESH_HAVE_OPENMP
-#pragma omp parallel for schedule (static)
-#endif
-  for (unsigned int i=0; i<n_threads; i++)
-    {
-#if !LIBMESH_HAVE_OPENMP
-      pthread_create(&threads[i], libmesh_nullptr, &run_body<Range, Body>, (void *)&range_bodies[i]);
-#else
-      run_body<Range, Body>((void *)&range_bodies[i]);
-#endif
-    }
-
-#if !LIBMESH_HAVE_OPENMP
-  // Wait for them to finish
-
-  // The use of 'int' instead of unsigned for the iteration variable
-  // is deliberate here.  This is an OpenMP loop, and some older
-  // compilers warn when you don't use int for the loop index.  The
-  // reason has to do with signed vs. unsigned integer overflow
-  // behavior and optimization.
-  // http://blog.llvm.org/2011/05/what-every-c-programmer-should-know.html
-  for (int i=0; i<static_cast<int>(n_threads); i++)
-    pthread_join(threads[i], libmesh_nullptr);
-#endif
+  // Cut the range into grain-size-aware chunks and let the thread
+  // pool balance them between threads.
+  RangeTask<Range, Body> range_task (range, pthread_chunk_size(range, n_threads));
+  range_task.const_body = &body;
 
-  // Clean up
-  for (unsigned int i=0; i<n_threads; i++)
-    delete ranges[i];
+  ThreadPool::instance().run(range_task.n_tasks,
+                             &RangeTask<Range, Body>::run_for,
+                             &range_task, n_threads);
 
 #ifdef LIBMESH_ENABLE_PERFORMANCE_LOGGING
   if (libMesh::n_threads() > 1 && logging_was_enabled)
@@ -375,80 +587,40 @@ void parallel_reduce (const Range & range, Body & body)
     libMesh::perflog.disable_logging();
 #endif
 
-  unsigned int n_threads = num_pthreads(range);
-
-  std::vector<Range *> ranges(n_threads);
-  std::vector<Body *> bodies(n_threads);
-  std::vector<RangeBody<Range, Body>> range_bodies(n_threads);
+  const unsigned int n_threads = num_pthreads(range);
 
-  // Create copies of the body for each thread
-  bodies[0] = &body; // Use the original body for the first one
-  for (unsigned int i=1; i<n_threads; i++)
-    bodies[i] = new Body(body, Threads::split());
+  // Each body is applied to exactly one contiguous subrange, as with
+  // the threads we used to spawn per loop: some bodies (e.g. the
+  // sparsity pattern's nonzero estimates) can't be accumulated over
+  // several subranges.  The pool still decides which thread runs
+  // which subrange, but there is nothing to steal.
+  RangeTask<Range, Body> range_task
+    (range, std::max(std::size_t(1), (range.size() + n_threads - 1) / n_threads));
 
-  // Create the ranges for each thread
-  unsigned int range_size = range.size() / n_threads;
+  const std::size_t n_bodies = std::max(range_task.n_tasks, std::size_t(1));
 
-  typename Range::const_iterator current_beginning = range.begin();
-
-  for (unsigned int i=0; i<n_threads; i++)
-    {
-      unsigned int this_range_size = range_size;
+  std::vector<Body *> & bodies = range_task.bodies;
+  bodies.resize(n_bodies);
 
-      if (i+1 == n_threads)
-        this_range_size += range.size() % n_threads; // Give the last one the remaining work to do
-
-      ranges[i] = new Range(range, current_beginning, current_beginning + this_range_size);
-
-      current_beginning = current_beginning + this_range_size;
-    }
-
-  // Create the RangeBody arguments
-  for (unsigned int i=0; i<n_threads; i++)
-    {
-      range_bodies[i].range = ranges[i];
-      range_bodies[i].body = bodies[i];
-    }
-
-  // Create the threads
-  std::vector<pthread_t> threads(n_threads);
-
-  // It may seem redundant to wrap a pragma in #ifdefs... but GCC
-  // warns about an "unknown pragma" if it encounters this line of
-  // code when -fopenmp is not passed to the compiler.
-#ifdef LIBMESH_HAVE_OPENMP
-#pragma omp parallel for schedule (static)
-#endif
-  // The use of 'int' instead of unsigned for the iteration variable
-  // is deliberate here.  This is an OpenMP loop, and some older
-  // compilers warn when you don't use int for the loop index.  The
-  // reason has to do with signed vs. unsigned integer overflow
-  // behavior and optimization.
-  // http://blog.llvm.org/2011/05/what-every-c-programmer-should-know.html
-  for (int i=0; i<static_cast<int>(n_threads); i++)
-    {
-#if !LIBMESH_HAVE_OPENMP
-      pthread_create(&threads[i], libmesh_nullptr, &run_body<Range, Body>, (void *)&range_bodies[i]);
-#else
-      run_body<Range, Body>((void *)&range_bodies[i]);
-#endif
-    }
+  // Create copies of the body for each subrange
+  bodies[0] = &body; // Use the original body for the first one
+  for (std::size_t i=1; i<n_bodies; i++)
+    bodies[i] = new Body(body, Threads::split());
 
-#if !LIBMESH_HAVE_OPENMP
-  // Wait for them to finish
-  for (unsigned int i=0; i<n_threads; i++)
-    pthread_join(threads[i], libmesh_nullptr);
-#endif
+  if (range_task.n_tasks)
+    ThreadPool::instance().run(range_task.n_tasks,
+                               &RangeTask<Range, Body>::run_reduce,
+                               &range_task, n_threads);
+  else
+    body(range);
 
   // Join them all down to the original Body
-  for (unsigned int i=n_threads-1; i != 0; i--)
+  for (std::size_t i=n_bodies-1; i != 0; i--)
     bodies[i-1]->join(*bodies[i]);
 
   // Clean up
-  for (unsigned int i=1; i<n_threads; i++)
+  for (std::size_t i=1; i<n_bodies; i++)
     delete bodies[i];
-  for (unsigned int i=0; i<n_threads; i++)
-    delete ranges[i];
 
 #ifdef LIBMESH_ENABLE_PERFORMANCE_LOGGING
   if (libMesh::n_threads() > 1 && logging_was_enabled)
@@ -88,6 +88,29 @@ public:
     return *_linear_solver;
   }
 
+  /**
+   * Attaches a shell matrix to use in place of the system matrix.
+   * Each Newton step then assembles only the residual, and the linear
+   * solver sees the Jacobian only through products with \p
+   * shell_jacobian (e.g. an FEMShellMatrix), preconditioned with the
+   * system's "Preconditioner" matrix if it has one.  Pass NULL to go
+   * back to the assembled Jacobian.  The shell matrix itself has to
+   * be stored elsewhere.
+   */
+  void attach_shell_jacobian (ShellMatrix<Number> * shell_jacobian)
+  { _shell_jacobian = shell_jacobian; }
+
+  /**
+   * Detaches a shell Jacobian.  Same as \p attach_shell_jacobian(libmesh_nullptr).
+   */
+  void detach_shell_jacobian () { attach_shell_jacobian(libmesh_nullptr); }
+
+  /**
+   * \returns A pointer to the currently attached shell Jacobian, if any,
+   * otherwise \p NULL.
+   */
+  ShellMatrix<Number> * get_shell_jacobian () { return _shell_jacobian; }
+
   /**
    * If this is set to true, the solver is forced to test the residual
    * after each Newton step, and to reduce the length of its steps
@@ -152,6 +175,12 @@ protected:
    */
   std::unique_ptr<LinearSolver<Number>> _linear_solver;
 
+  /**
+   * User-supplied Jacobian operator, or \p NULL to use the system
+   * matrix.
+   */
+  ShellMatrix<Number> * _shell_jacobian;
+
   /**
    * This does a line search in the direction opposite \p linear_solution
    * to try and minimize the residual of \p newton_iterate.
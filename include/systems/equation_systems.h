@@ -46,6 +46,7 @@ namespace libMesh
 {
 
 // Forward Declarations
+class BackgroundWriter;
 class Elem;
 class MeshBase;
 
@@ -81,11 +82,16 @@ public:
 
   /**
    * Define enumeration to set properties in EquationSystems::write()
+   *
+   * WRITE_DELTA_DATA implies WRITE_PARALLEL_FILES, and writes each
+   * vector as a delta against what each System last wrote; see
+   * System::write_parallel_data().
    */
   enum WriteFlags { WRITE_DATA             = 1,
                     WRITE_ADDITIONAL_DATA  = 2,
                     WRITE_PARALLEL_FILES   = 4,
-                    WRITE_SERIAL_FILES     = 8 };
+                    WRITE_SERIAL_FILES     = 8,
+                    WRITE_DELTA_DATA       = 16 };
 
   /**
    * Constructor.
@@ -392,15 +398,20 @@ public:
    * files written using "n" mpi processes can be re-read on "m" mpi
    * processes.  This renumbering is not compatible with meshes
    * that have two nodes in exactly the same position!
+   * \param writer If not null, the files are gathered into memory and
+   * this returns while \p writer writes them on background threads;
+   * call \p writer->wait() before relying on them being on disk.
    */
   void write (const std::string & name,
               const XdrMODE,
               const unsigned int write_flags=(WRITE_DATA),
-              bool partition_agnostic = true) const;
+              bool partition_agnostic = true,
+              BackgroundWriter * writer = libmesh_nullptr) const;
 
   void write (const std::string & name,
               const unsigned int write_flags=(WRITE_DATA),
-              bool partition_agnostic = true) const;
+              bool partition_agnostic = true,
+              BackgroundWriter * writer = libmesh_nullptr) const;
 
   /**
    * \returns \p true when this equation system contains
@@ -748,6 +748,20 @@ public:
    */
   virtual void elem_fe_reinit(const std::vector<Point> * const pts = libmesh_nullptr);
 
+  /**
+   * Computes quadrature point locations, Jacobians, inverse Jacobians
+   * and JxW on a whole batch \p elems of elements at once, using the
+   * interior quadrature rule for their dimension, which is first
+   * initialized for their type and p-level.  All of \p elems must
+   * share the same type and p-level.  This is a cheaper alternative
+   * to calling elem_fe_reinit() on each element for physics which
+   * only need geometric data, e.g. to integrate quantities which are
+   * evaluated separately.  See FEMap::compute_batch_map() for the
+   * layout of \p data.
+   */
+  void elem_batch_map(const std::vector<const Elem *> & elems,
+                      FEMap::BatchData & data);
+
   /**
    * Reinitializes side FE objects on the current geometric element
    */
@@ -0,0 +1,97 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+
+#ifndef LIBMESH_FEM_SHELL_MATRIX_H
+#define LIBMESH_FEM_SHELL_MATRIX_H
+
+// Local includes
+#include "libmesh/shell_matrix.h"
+
+namespace libMesh
+{
+
+// Forward declarations
+class FEMSystem;
+
+/**
+ * This class exposes the Jacobian of an FEMSystem as a shell matrix,
+ * so that linear solvers can work with it without it ever being
+ * assembled.  Each product recomputes the element Jacobians at the
+ * solution localized by the system's last update() or assembly()
+ * call (with the user's element and side residual functions, or
+ * finite differences of them if they do not provide Jacobians) and
+ * applies them element by element.  See
+ * FEMSystem::jacobian_vector_mult_add().
+ *
+ * To run Newton iterations without a stored matrix, attach one to a
+ * NewtonSolver and tell the system not to allocate its matrix:
+ * \code
+ * system.allocate_system_matrix = false;
+ * es.init();
+ * FEMShellMatrix jacobian(system);
+ * NewtonSolver & solver =
+ *   cast_ref<NewtonSolver &>(*system.time_solver->diff_solver());
+ * solver.attach_shell_jacobian(&jacobian);
+ * \endcode
+ *
+ * This trades memory for repeated element Jacobian evaluations, one
+ * set per Krylov iteration.  All overridden virtual functions are
+ * documented in shell_matrix.h.
+ *
+ * \brief Matrix-free application of an FEMSystem Jacobian.
+ */
+class FEMShellMatrix : public ShellMatrix<Number>
+{
+public:
+  /**
+   * Constructor; takes a reference to the system whose Jacobian is
+   * to be applied.
+   */
+  explicit
+  FEMShellMatrix (FEMSystem & system);
+
+  /**
+   * Destructor.
+   */
+  virtual ~FEMShellMatrix ();
+
+  virtual numeric_index_type m () const libmesh_override;
+
+  virtual numeric_index_type n () const libmesh_override;
+
+  virtual void vector_mult (NumericVector<Number> & dest,
+                            const NumericVector<Number> & arg) const libmesh_override;
+
+  virtual void vector_mult_add (NumericVector<Number> & dest,
+                                const NumericVector<Number> & arg) const libmesh_override;
+
+  virtual void get_diagonal (NumericVector<Number> & dest) const libmesh_override;
+
+protected:
+  /**
+   * The system.
+   */
+  FEMSystem & _system;
+};
+
+} // namespace libMesh
+
+
+#endif // LIBMESH_FEM_SHELL_MATRIX_H
@@ -202,6 +202,71 @@ public:
    */
   Real verify_analytic_jacobians;
 
+  /**
+   * The number of element contributions each thread may stage
+   * locally during assembly() before adding them to the global
+   * matrix and residual.  With the default value of 1, every element
+   * takes the global assembly lock in turn.  Larger values let
+   * threads add their staged elements whenever the lock is free once
+   * the buffer is half full, and only wait once it is full, which
+   * greatly reduces lock contention at high thread counts, at the
+   * cost of memory for that many element matrices per thread.
+   */
+  unsigned int assembly_buffer_size;
+
+  /**
+   * If colored_assembly is true (it is false by default), assembly()
+   * works through the colors of
+   * DofMap::active_local_element_coloring() in turn, and threads
+   * assembling elements of the same color add to the global matrix
+   * and residual without taking the assembly lock, since those
+   * elements write to no common dofs even after constraints are
+   * applied.
+   *
+   * The lock is still taken unless the matrix and residual being
+   * assembled both report supports_concurrent_add(), and systems
+   * with SCALAR variables, which couple every element, are always
+   * assembled with the lock.
+   */
+  bool colored_assembly;
+
+  /**
+   * If use_element_blocks is true (it is false by default), the
+   * threaded element loops of assembly(), postprocess(),
+   * assemble_qoi(), assemble_qoi_derivative(),
+   * jacobian_vector_mult_add() and jacobian_diagonal() divide the active local elements by
+   * MeshBase::active_local_element_blocks(), so that each thread
+   * starts out on its own compact part of the mesh, rather than in
+   * the mesh's element order.
+   */
+  bool use_element_blocks;
+
+  /**
+   * Adds J * \p arg to \p dest, where J is the Jacobian which
+   * assembly(false, true) would assemble at the current solution,
+   * constraints included.  J is never stored: each element Jacobian
+   * is computed, applied and discarded in turn, using the same
+   * physics and time solver calls as assembly().  \p arg and \p
+   * dest must be parallel vectors with this system's dof layout.
+   *
+   * The element Jacobians are evaluated at current_local_solution,
+   * which is not localized again for each product, since a Krylov
+   * solve applies the operator many times at the same solution.
+   * Call update() (or assembly(), which does) after changing the
+   * solution; NewtonSolver does so once per step.
+   *
+   * This is the operator applied by FEMShellMatrix.
+   */
+  void jacobian_vector_mult_add (NumericVector<Number> & dest,
+                                 const NumericVector<Number> & arg);
+
+  /**
+   * Computes the diagonal of the Jacobian applied by
+   * jacobian_vector_mult_add() into \p dest, again without storing
+   * the Jacobian, at the solution last localized by update().
+   */
+  void jacobian_diagonal (NumericVector<Number> & dest);
+
   /**
    * Syntax sugar to make numerical_jacobian() declaration easier.
    */
@@ -243,6 +308,14 @@ protected:
   virtual void init_data () libmesh_override;
 
 private:
+  /**
+   * Applies each element Jacobian to the ghosted vector \p
+   * local_arg, or extracts its diagonal if \p local_arg is NULL, and
+   * adds the results to \p dest.
+   */
+  void apply_element_jacobians (const NumericVector<Number> * local_arg,
+                                NumericVector<Number> & dest);
+
   std::vector<Real> _numerical_jacobian_h_for_var;
 };
 
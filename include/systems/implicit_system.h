@@ -356,6 +356,17 @@ public:
    */
   bool zero_out_matrix_and_rhs;
 
+  /**
+   * By default, the system matrix is allocated (and a sparsity
+   * pattern is computed for it) when the system is initialized.
+   * Solvers which only apply the system Jacobian through a
+   * ShellMatrix, such as a NewtonSolver with an attached
+   * FEMShellMatrix, never store anything in it; setting this flag to
+   * false before initialization saves its memory.  Any additional
+   * matrices (e.g. a "Preconditioner" matrix) are still allocated.
+   */
+  bool allocate_system_matrix;
+
 protected:
 
   /**
@@ -1284,10 +1284,16 @@ public:
    * This method may safely be called on a distributed-memory mesh.
    * This method will read an individual file for each processor in the simulation
    * where the local solution components for that processor are stored.
+   *
+   * If \p delta is \p true the data is expected in the format written
+   * by \p write_parallel_data() with \p delta set, and files must be
+   * read in the order they were written, starting from one holding
+   * keyframes.
    */
   template <typename InValType>
   void read_parallel_data (Xdr & io,
-                           const bool read_additional_data);
+                           const bool read_additional_data,
+                           const bool delta = false);
 
   /**
    * Non-templated version for backward compatibility.
@@ -1298,8 +1304,9 @@ public:
    * where the local solution components for that processor are stored.
    */
   void read_parallel_data (Xdr & io,
-                           const bool read_additional_data)
-  { read_parallel_data<Number>(io, read_additional_data); }
+                           const bool read_additional_data,
+                           const bool delta = false)
+  { read_parallel_data<Number>(io, read_additional_data, delta); }
 
   /**
    * Writes the basic data header for this System.
@@ -1328,9 +1335,31 @@ public:
    * This method may safely be called on a distributed-memory mesh.
    * This method will create an individual file for each processor in the simulation
    * where the local solution components for that processor will be stored.
+   *
+   * If \p delta is \p true each vector is written XOR'ed against the
+   * values it had when this System last wrote or read delta data, with
+   * the bytes that did not change left out.  The values are
+   * remembered by position in the file, not by vector name, so a
+   * vector added since the last write is compared against whichever
+   * vector was written in its place.  A vector is written in full, as
+   * a keyframe, only when nothing of the same size was written in its
+   * place, which includes the first write and any change in the local
+   * dof layout.  The mesh itself is never written here; write it
+   * once, e.g. with \p CheckpointIO, for as long as it does not
+   * change.
    */
   void write_parallel_data (Xdr & io,
-                            const bool write_additional_data) const;
+                            const bool write_additional_data,
+                            const bool delta = false) const;
+
+  /**
+   * Forgets the values remembered for \p write_parallel_data() and \p
+   * read_parallel_data() with \p delta set, so that the next delta
+   * data written starts with keyframes.  Call this e.g. to start a new
+   * chain of restart files which can be read independently of the
+   * earlier ones.
+   */
+  void clear_delta_reference ();
 
   /**
    * \returns A string containing information about the
@@ -1812,6 +1841,28 @@ private:
   dof_id_type write_serialized_vector (Xdr & io,
                                        const NumericVector<Number> & vec) const;
 
+  /**
+   * Writes the entries \p indices of \p vec to the stream \p io as a
+   * delta against \p _delta_reference[\p record], or as a keyframe if
+   * there is no suitable reference, and updates the reference.
+   */
+  void write_delta_vector (Xdr & io,
+                           const NumericVector<Number> & vec,
+                           const std::vector<dof_id_type> & indices,
+                           const unsigned int record,
+                           const std::string & comment) const;
+
+  /**
+   * Reads a vector written by \p write_delta_vector(), assigns the
+   * values to the entries \p indices of \p vec and updates the
+   * reference.  The values are read but not assigned if \p vec is a
+   * null pointer.
+   */
+  void read_delta_vector (Xdr & io,
+                          NumericVector<Number> * vec,
+                          const std::vector<dof_id_type> & indices,
+                          const unsigned int record);
+
   /**
    * Function that initializes the system.
    */
@@ -1989,6 +2040,18 @@ private:
    */
   std::vector<unsigned int> _written_var_indices;
 
+  /**
+   * The local values of the solution (record 0) and of each
+   * additional vector, in file order, as last written or read as delta
+   * data.  Delta records are XOR'ed against these.
+   */
+  mutable std::vector<std::vector<Number>> _delta_reference;
+
+  /**
+   * A hash of the local dof layout \p _delta_reference was taken with.
+   */
+  mutable unsigned long long _delta_layout_hash;
+
   /**
    * Has the adjoint problem already been solved?  If the user sets
    * \p adjoint_already_solved to \p true, we won't waste time solving
@@ -0,0 +1,130 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_BACKGROUND_WRITER_H
+#define LIBMESH_BACKGROUND_WRITER_H
+
+// Local includes
+#include "libmesh/libmesh_common.h"
+#include "libmesh/enum_xdr_mode.h"
+
+// C++ includes
+#include <list>
+#include <memory>
+#include <string>
+
+namespace libMesh
+{
+
+/**
+ * Writes files out on background threads, so that the thread which
+ * produced them can carry on while they are written and compressed.
+ *
+ * An \p Xdr object given a \p BackgroundWriter buffers everything
+ * written to it in memory, and hands the buffer over when it is
+ * closed.  This lets \p EquationSystems::write() and \p
+ * CheckpointIO::write() return once the restart data has been
+ * gathered, rather than once it is on disk.  Gathering is still done
+ * by the calling thread, since it may need to communicate.
+ *
+ * Files handed over are not guaranteed to be complete until \p
+ * wait() returns; in particular, don't read them back before then.
+ */
+class BackgroundWriter
+{
+public:
+
+  /**
+   * Constructor.  No more than \p max_buffered_bytes of file
+   * contents will be held in memory at once: \p write() waits for
+   * earlier files to be written when necessary.  The default, 0,
+   * sets no limit.
+   */
+  explicit
+  BackgroundWriter (std::size_t max_buffered_bytes = 0);
+
+  /**
+   * Destructor.  Waits for every file to be written.
+   */
+  ~BackgroundWriter ();
+
+  /**
+   * Starts writing \p contents, the complete contents of a file
+   * which would have been written to \p name with mode \p mode, on a
+   * background thread.  ASCII files are compressed as their name
+   * suggests.  \p contents is taken over, leaving it empty.
+   */
+  void write (const std::string & name,
+              const XdrMODE mode,
+              std::string & contents);
+
+  /**
+   * Waits until every file handed to \p write() so far is on disk,
+   * and frees their buffers.  Throws an error naming any file which
+   * could not be written.
+   */
+  void wait ();
+
+  /**
+   * \returns \p true if any files are still being written.
+   */
+  bool busy ();
+
+  /**
+   * \returns The number of bytes of file contents currently held in
+   * memory.
+   */
+  std::size_t buffered_bytes () const { return _buffered_bytes; }
+
+  /**
+   * \returns The limit on \p buffered_bytes(), or 0 if there is none.
+   */
+  std::size_t max_buffered_bytes () const { return _max_buffered_bytes; }
+
+private:
+
+  /**
+   * A file being written, which is defined in the implementation file.
+   */
+  struct Job;
+
+  /**
+   * Waits for the oldest file to be written, and frees its buffer.
+   */
+  void finish_oldest ();
+
+  /**
+   * The files still being written, oldest first.
+   */
+  std::list<std::unique_ptr<Job>> _jobs;
+
+  std::size_t _buffered_bytes;
+
+  const std::size_t _max_buffered_bytes;
+
+  /**
+   * The names of files which could not be written, to be reported by
+   * \p wait().
+   */
+  std::string _failures;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_BACKGROUND_WRITER_H
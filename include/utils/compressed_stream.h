@@ -0,0 +1,208 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_COMPRESSED_STREAM_H
+#define LIBMESH_COMPRESSED_STREAM_H
+
+// Local includes
+#include "libmesh/libmesh_common.h"
+
+// C++ includes
+#include <cstdio> // FILE
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace libMesh
+{
+
+/**
+ * A stream buffer which compresses everything written to it into a
+ * file, or decompresses a file as it is read, using one of the
+ * compression libraries libMesh was configured with.  This lets
+ * large files be written and read compressed directly, rather than
+ * through a temporary uncompressed copy.
+ *
+ * The xz and zstd formats are compressed in independent blocks on
+ * multiple threads when more than one thread is requested; bzip2 is
+ * always compressed serially.  Files made of several concatenated
+ * compressed streams, as written by parallel compressors such as
+ * pbzip2, are read as a whole.
+ */
+class CompressedStreamBuf : public std::streambuf
+{
+public:
+
+  /**
+   * The compressed file formats we may support.
+   */
+  enum Format { BZIP2, XZ, ZSTD };
+
+  /**
+   * \returns \p true if this build of libMesh can stream files in
+   * the given \p format.
+   */
+  static bool available (Format format);
+
+  /**
+   * \returns \p true if \p name ends with the suffix of a compressed
+   * format, setting \p format accordingly; the format may not be
+   * available.
+   */
+  static bool format_from_name (const std::string & name,
+                                Format & format);
+
+  /**
+   * Constructor.  Opens file \p name, for reading if \p mode includes
+   * \p std::ios::in and for writing (and truncation) otherwise.
+   * Compression uses up to \p n_threads threads where the format
+   * allows it.
+   */
+  CompressedStreamBuf (const std::string & name,
+                       Format format,
+                       std::ios_base::openmode mode,
+                       unsigned int n_threads = 1);
+
+  /**
+   * Destructor.  Finishes and closes the file.
+   */
+  ~CompressedStreamBuf ();
+
+  /**
+   * \returns \p true if the file was opened successfully and has not
+   * been closed.
+   */
+  bool is_open () const { return _file != libmesh_nullptr; }
+
+  /**
+   * Compresses any buffered output, finishes the compressed stream
+   * and closes the file.  \returns \p false if any of that failed.
+   */
+  bool close ();
+
+protected:
+
+  virtual int_type underflow () libmesh_override;
+
+  virtual int_type overflow (int_type c) libmesh_override;
+
+  virtual int sync () libmesh_override;
+
+private:
+
+  /**
+   * The interface to each compression library, which is defined in
+   * the implementation file so that users of this header don't need
+   * the libraries' headers.
+   */
+  class Codec;
+
+  /**
+   * Compresses and writes out the contents of the put area.  If \p
+   * finish is \p true, also ends the compressed stream.  \returns \p
+   * false on a write error.
+   */
+  bool write_out (bool finish);
+
+  std::unique_ptr<Codec> _codec;
+
+  std::FILE * _file;
+
+  /**
+   * \p true if we are reading, \p false if writing.
+   */
+  bool _reading;
+
+  /**
+   * \p true once we have read the whole file.
+   */
+  bool _file_done;
+
+  /**
+   * \p true once the codec has seen the end of the compressed data.
+   */
+  bool _stream_done;
+
+  /**
+   * Uncompressed data, to be compressed or handed out to the stream.
+   */
+  std::vector<char> _buffer;
+
+  /**
+   * Compressed data, read from or to be written to the file, and the
+   * range of it which has been read but not yet decompressed.
+   */
+  std::vector<char> _compressed;
+  std::size_t _compressed_begin, _compressed_end;
+};
+
+
+
+/**
+ * An input stream which decompresses a file as it is read.
+ */
+class CompressedIStream : public std::istream
+{
+public:
+  /**
+   * Constructor.  Opens file \p name for reading; \p fail() is set if
+   * that is not possible.
+   */
+  CompressedIStream (const std::string & name,
+                     CompressedStreamBuf::Format format,
+                     unsigned int n_threads = 1);
+
+private:
+  CompressedStreamBuf _buf;
+};
+
+
+
+/**
+ * An output stream which compresses everything written to it into a
+ * file.  The file is complete once the stream is closed or
+ * destroyed.
+ */
+class CompressedOStream : public std::ostream
+{
+public:
+  /**
+   * Constructor.  Opens file \p name for writing; \p fail() is set if
+   * that is not possible.
+   */
+  CompressedOStream (const std::string & name,
+                     CompressedStreamBuf::Format format,
+                     unsigned int n_threads = 1);
+
+  /**
+   * Finishes and closes the file, setting \p fail() if any of the
+   * output could not be written.
+   */
+  void close ();
+
+private:
+  CompressedStreamBuf _buf;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_COMPRESSED_STREAM_H
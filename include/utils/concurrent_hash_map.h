@@ -0,0 +1,418 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_CONCURRENT_HASH_MAP_H
+#define LIBMESH_CONCURRENT_HASH_MAP_H
+
+// libMesh includes
+#include "libmesh/libmesh_common.h"
+#include "libmesh/threads.h"
+
+// C++ includes
+#include <cstddef>
+#include <cstdint>
+#include <functional> // std::hash
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace libMesh
+{
+
+/**
+ * This \p concurrent_hash_map templated class is a hash map with
+ * flat, open-addressing storage, which many threads may insert into
+ * and search at once.
+ *
+ * Entries are spread over a fixed number of shards by the high bits
+ * of their hash, after mixing, and each shard is a power-of-two
+ * table of slots, probed linearly from the low bits and locked by
+ * its own spin_mutex.  Threads working in different shards never
+ * wait for each other.  A shard doubles its table when more than
+ * half its slots are full; there is no allocation per entry, unlike
+ * the std::unordered containers.
+ *
+ * Values are returned by copy, since another thread may move them
+ * by growing their shard at any time.  There is no erase() and no
+ * iteration: these maps are built, searched, and cleared.
+ *
+ * Besides the unique-key insert(), insert_multi() adds an entry even
+ * if its key is already present, so the class can stand in for a
+ * hashed multimap, and find_if() then searches all the values with
+ * a key.  Their order depends on the order of insertion, which
+ * threads don't keep; find_min_if() picks among them independently
+ * of it.
+ */
+template <typename Key, typename Val, typename Hash = std::hash<Key>>
+class concurrent_hash_map
+{
+public:
+
+  /**
+   * Constructor.  The number of shards is rounded up to a power of
+   * two; the default is plenty for a few dozen threads.
+   */
+  explicit
+  concurrent_hash_map (unsigned int n_shards = 64) :
+    _shard_bits(0)
+  {
+    while ((1u << _shard_bits) < n_shards)
+      ++_shard_bits;
+    _shards.reset(new Shard[this->n_shards()]);
+  }
+
+  concurrent_hash_map (const concurrent_hash_map<Key, Val, Hash> & other) :
+    _shard_bits(other._shard_bits),
+    _hash(other._hash)
+  {
+    _shards.reset(new Shard[this->n_shards()]);
+    *this = other;
+  }
+
+  /**
+   * Assignment.  Neither map may be in use by other threads.
+   */
+  concurrent_hash_map<Key, Val, Hash> &
+  operator= (const concurrent_hash_map<Key, Val, Hash> & other)
+  {
+    if (&other == this)
+      return *this;
+
+    if (_shard_bits != other._shard_bits)
+      {
+        _shard_bits = other._shard_bits;
+        _shards.reset(new Shard[this->n_shards()]);
+      }
+
+    _hash = other._hash;
+
+    for (std::size_t s = 0; s != this->n_shards(); ++s)
+      {
+        _shards[s].slots = other._shards[s].slots;
+        _shards[s].used = other._shards[s].used;
+        _shards[s].n_used = other._shards[s].n_used;
+      }
+
+    return *this;
+  }
+
+  /**
+   * \returns The number of entries.
+   */
+  std::size_t size () const
+  {
+    std::size_t n = 0;
+    for (std::size_t s = 0; s != this->n_shards(); ++s)
+      {
+        Threads::spin_mutex::scoped_lock lock(_shards[s].mutex);
+        n += _shards[s].n_used;
+      }
+    return n;
+  }
+
+  bool empty () const { return !this->size(); }
+
+  /**
+   * Removes all entries and frees their storage.
+   */
+  void clear ()
+  {
+    for (std::size_t s = 0; s != this->n_shards(); ++s)
+      {
+        Shard & shard = _shards[s];
+        Threads::spin_mutex::scoped_lock lock(shard.mutex);
+        std::vector<Slot>().swap(shard.slots);
+        std::vector<unsigned char>().swap(shard.used);
+        shard.n_used = 0;
+      }
+  }
+
+  /**
+   * Makes room for about \p n entries in all, so that filling the
+   * map rarely has to grow a shard.
+   */
+  void reserve (std::size_t n)
+  {
+    const std::size_t per_shard = n / this->n_shards() + 1;
+    for (std::size_t s = 0; s != this->n_shards(); ++s)
+      {
+        Shard & shard = _shards[s];
+        Threads::spin_mutex::scoped_lock lock(shard.mutex);
+        while (2 * per_shard > shard.slots.size())
+          this->grow(shard);
+      }
+  }
+
+  /**
+   * Adds an entry for \p key with value \p val, unless there is one
+   * already.
+   *
+   * \returns The value now stored for \p key, and whether it is \p
+   * val, newly inserted.
+   */
+  std::pair<Val, bool> insert (const Key & key, const Val & val)
+  {
+    Shard & shard = this->shard_of(key);
+    Threads::spin_mutex::scoped_lock lock(shard.mutex);
+
+    const std::size_t i = this->find_or_make_slot(shard, key);
+    if (shard.used[i])
+      return std::make_pair(shard.slots[i].val, false);
+
+    this->fill_slot(shard, i, key, val);
+    return std::make_pair(val, true);
+  }
+
+  /**
+   * Adds an entry for \p key with value \p val if there is none, or
+   * else replaces the value \p old stored for \p key with \p
+   * combine(old, val), all as one atomic operation.
+   *
+   * \returns The value now stored for \p key.
+   */
+  template <typename Combine>
+  Val insert_or_combine (const Key & key, const Val & val, Combine combine)
+  {
+    Shard & shard = this->shard_of(key);
+    Threads::spin_mutex::scoped_lock lock(shard.mutex);
+
+    const std::size_t i = this->find_or_make_slot(shard, key);
+    if (shard.used[i])
+      shard.slots[i].val = combine(shard.slots[i].val, val);
+    else
+      this->fill_slot(shard, i, key, val);
+
+    return shard.slots[i].val;
+  }
+
+  /**
+   * Adds an entry for \p key with value \p val, whether or not there
+   * are entries for \p key already.
+   */
+  void insert_multi (const Key & key, const Val & val)
+  {
+    Shard & shard = this->shard_of(key);
+    Threads::spin_mutex::scoped_lock lock(shard.mutex);
+
+    this->reserve_one(shard);
+
+    const std::size_t mask = shard.slots.size() - 1;
+    std::size_t i = this->hash(key) & mask;
+    while (shard.used[i])
+      i = (i + 1) & mask;
+
+    this->fill_slot(shard, i, key, val);
+  }
+
+  /**
+   * Copies the value for \p key, if there is an entry for \p key,
+   * into \p val.
+   *
+   * \returns \p true if there was an entry.
+   */
+  bool find (const Key & key, Val & val) const
+  {
+    const Shard & shard = this->shard_of(key);
+    Threads::spin_mutex::scoped_lock lock(shard.mutex);
+
+    if (shard.slots.empty())
+      return false;
+
+    const std::size_t mask = shard.slots.size() - 1;
+    for (std::size_t i = this->hash(key) & mask; shard.used[i];
+         i = (i + 1) & mask)
+      if (shard.slots[i].key == key)
+        {
+          val = shard.slots[i].val;
+          return true;
+        }
+
+    return false;
+  }
+
+  /**
+   * Copies the first value stored for \p key for which \p pred(value)
+   * is true, if any, into \p val.  \p pred is called with the shard
+   * locked, so it must not use the map.
+   *
+   * \returns \p true if such a value was found.
+   */
+  template <typename Predicate>
+  bool find_if (const Key & key, Predicate pred, Val & val) const
+  {
+    const Shard & shard = this->shard_of(key);
+    Threads::spin_mutex::scoped_lock lock(shard.mutex);
+
+    if (shard.slots.empty())
+      return false;
+
+    const std::size_t mask = shard.slots.size() - 1;
+    for (std::size_t i = this->hash(key) & mask; shard.used[i];
+         i = (i + 1) & mask)
+      if (shard.slots[i].key == key && pred(shard.slots[i].val))
+        {
+          val = shard.slots[i].val;
+          return true;
+        }
+
+    return false;
+  }
+
+  /**
+   * Copies the least value, by \p less, of those stored for \p key
+   * for which \p pred(value) is true, if any, into \p val.  Unlike
+   * find_if(), the result doesn't depend on the order in which the
+   * values were inserted.  \p pred and \p less are called with the
+   * shard locked, so they must not use the map.
+   *
+   * \returns \p true if such a value was found.
+   */
+  template <typename Predicate, typename Compare>
+  bool find_min_if (const Key & key, Predicate pred, Compare less, Val & val) const
+  {
+    const Shard & shard = this->shard_of(key);
+    Threads::spin_mutex::scoped_lock lock(shard.mutex);
+
+    if (shard.slots.empty())
+      return false;
+
+    bool found = false;
+    const std::size_t mask = shard.slots.size() - 1;
+    for (std::size_t i = this->hash(key) & mask; shard.used[i];
+         i = (i + 1) & mask)
+      if (shard.slots[i].key == key && pred(shard.slots[i].val) &&
+          (!found || less(shard.slots[i].val, val)))
+        {
+          val = shard.slots[i].val;
+          found = true;
+        }
+
+    return found;
+  }
+
+private:
+
+  struct Slot
+  {
+    Key key;
+    Val val;
+  };
+
+  /**
+   * An open-addressing table, which is empty or has a power-of-two
+   * number of slots, at most half of them used.
+   */
+  struct Shard
+  {
+    Shard () : n_used(0) {}
+
+    mutable Threads::spin_mutex mutex;
+    std::vector<Slot> slots;
+    std::vector<unsigned char> used;
+    std::size_t n_used;
+  };
+
+  std::size_t n_shards () const
+  { return std::size_t(1) << _shard_bits; }
+
+  /**
+   * \returns The hash of \p key, mixed so that both its high bits
+   * (which choose the shard) and its low bits (which choose the
+   * slot) depend on every bit of the user hash; the std::hash of an
+   * integer is the integer itself.
+   */
+  std::uint64_t hash (const Key & key) const
+  {
+    std::uint64_t h = _hash(key);
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+  }
+
+  Shard & shard_of (const Key & key)
+  { return _shards[_shard_bits ? this->hash(key) >> (64 - _shard_bits) : 0]; }
+
+  const Shard & shard_of (const Key & key) const
+  { return _shards[_shard_bits ? this->hash(key) >> (64 - _shard_bits) : 0]; }
+
+  /**
+   * \returns The slot holding \p key, or else the empty slot where
+   * \p key belongs, after making room for one more entry.
+   */
+  std::size_t find_or_make_slot (Shard & shard, const Key & key)
+  {
+    this->reserve_one(shard);
+
+    const std::size_t mask = shard.slots.size() - 1;
+    std::size_t i = this->hash(key) & mask;
+    while (shard.used[i] && !(shard.slots[i].key == key))
+      i = (i + 1) & mask;
+
+    return i;
+  }
+
+  void fill_slot (Shard & shard, std::size_t i,
+                  const Key & key, const Val & val)
+  {
+    shard.slots[i].key = key;
+    shard.slots[i].val = val;
+    shard.used[i] = 1;
+    ++shard.n_used;
+  }
+
+  void reserve_one (Shard & shard)
+  {
+    if (2 * (shard.n_used + 1) > shard.slots.size())
+      this->grow(shard);
+  }
+
+  /**
+   * Doubles the number of slots in \p shard, which must be locked.
+   */
+  void grow (Shard & shard)
+  {
+    std::vector<Slot> old_slots;
+    std::vector<unsigned char> old_used;
+    old_slots.swap(shard.slots);
+    old_used.swap(shard.used);
+
+    const std::size_t n_slots = old_slots.empty() ? 16 : 2 * old_slots.size();
+    shard.slots.resize(n_slots);
+    shard.used.resize(n_slots, 0);
+
+    const std::size_t mask = n_slots - 1;
+    for (std::size_t j = 0; j != old_slots.size(); ++j)
+      if (old_used[j])
+        {
+          std::size_t i = this->hash(old_slots[j].key) & mask;
+          while (shard.used[i])
+            i = (i + 1) & mask;
+          shard.slots[i] = old_slots[j];
+          shard.used[i] = 1;
+        }
+  }
+
+  unsigned int _shard_bits;
+  std::unique_ptr<Shard[]> _shards;
+  Hash _hash;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_CONCURRENT_HASH_MAP_H
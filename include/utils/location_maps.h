@@ -24,10 +24,10 @@
 
 // Local Includes
 #include "libmesh/libmesh_common.h"
+#include "libmesh/concurrent_hash_map.h"
 #include "libmesh/point.h"
 
 // C++ Includes
-#include <unordered_map>
 #include <vector>
 
 namespace libMesh
@@ -42,8 +42,10 @@ class Node;
 /**
  * Data structures that enable location-based lookups
  * The key is a hash of the Point location.
- * For efficiency we will use a hashed multimap if it is
- * available, otherwise a regular multimap.
+ * The multimap is a concurrent_hash_map, so insert() may be called
+ * from several threads at once, and init() fills it on all threads.
+ * Of several objects at the same point, find() returns the one with
+ * the lowest id, whatever order they were inserted in.
  *
  * \author Roy Stogner
  * \date 2008
@@ -52,7 +54,7 @@ class Node;
 template <typename T>
 class LocationMap
 {
-  typedef std::unordered_multimap<unsigned int, T *> map_type;
+  typedef concurrent_hash_map<unsigned int, T *> map_type;
 public:
   void init(MeshBase &);
 
@@ -63,12 +65,12 @@ public:
   bool empty() const { return _map.empty(); }
 
   T * find(const Point &,
-           const Real tol = TOLERANCE);
+           const Real tol = TOLERANCE) const;
 
   Point point_of(const T &) const;
 
 protected:
-  unsigned int key(const Point &);
+  unsigned int key(const Point &) const;
 
   void fill(MeshBase &);
 
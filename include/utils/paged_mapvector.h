@@ -0,0 +1,488 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_PAGED_MAPVECTOR_H
+#define LIBMESH_PAGED_MAPVECTOR_H
+
+// libMesh includes
+#include "libmesh/libmesh_common.h"
+
+// C++ includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libMesh
+{
+
+/**
+ * This \p paged_mapvector templated class provides the interface of
+ * \p mapvector (a sparse, id-indexed container which iterates in
+ * increasing id order) with O(1) lookup and mostly contiguous
+ * storage, for use with DistributedMesh.
+ *
+ * Ids are split into pages of \p page_size consecutive ids, which are
+ * found by direct indexing into a directory of page pointers.  Each
+ * page holds a bitmap of which of its ids are present and a compact
+ * array of the values for those ids, in id order.  A page with a
+ * single entry thus costs little more than a std::map node, while a
+ * fully populated page is nearly as compact as a std::vector.
+ *
+ * Iterators refer to an id rather than to storage, so erasing one
+ * entry does not invalidate iterators to any other entries; the
+ * "container.erase(it++)" idiom used with std::map remains valid.
+ * Like with \p mapvector, the non-const operator[] creates a
+ * default-valued entry for a missing id, while the const version
+ * returns a default value without creating an entry.
+ */
+template <typename Val, typename index_t=unsigned int>
+class paged_mapvector
+{
+public:
+
+  /**
+   * The number of consecutive ids stored in each page.
+   */
+  static const unsigned int page_bits = 8;
+  static const index_t page_size = static_cast<index_t>(1) << page_bits;
+
+  /**
+   * The key value used by end() iterators.
+   */
+  static const index_t end_key = static_cast<index_t>(-1);
+
+private:
+
+  static const unsigned int words_per_page = (1u << page_bits) / 64;
+
+  /**
+   * The ids [first, first + page_size) for some first.
+   */
+  struct Page
+  {
+    Page () { for (unsigned int w=0; w != words_per_page; ++w) present[w] = 0; }
+
+    uint64_t present[words_per_page];
+    std::vector<Val> values;
+  };
+
+public:
+
+  paged_mapvector () : _size(0) {}
+
+  paged_mapvector (const paged_mapvector<Val, index_t> & other) :
+    _size(0)
+  {
+    *this = other;
+  }
+
+  paged_mapvector<Val, index_t> &
+  operator= (const paged_mapvector<Val, index_t> & other)
+  {
+    if (&other == this)
+      return *this;
+
+    this->clear();
+    _pages.resize(other._pages.size(), libmesh_nullptr);
+    for (std::size_t p = 0; p != _pages.size(); ++p)
+      if (other._pages[p])
+        _pages[p] = new Page(*other._pages[p]);
+    _size = other._size;
+
+    return *this;
+  }
+
+  ~paged_mapvector () { this->clear(); }
+
+  /**
+   * \returns A writable reference to the value for id \p k, creating
+   * a default-valued entry if none exists.
+   */
+  Val & operator[] (const index_t & k)
+  {
+    Val * val = this->lookup(k);
+    if (val)
+      return *val;
+
+    return this->insert_default(k);
+  }
+
+  /**
+   * \returns The value for id \p k, or a default-constructed value if
+   * there is no entry for \p k.
+   */
+  Val operator[] (const index_t & k) const
+  {
+    const Val * val = this->lookup(k);
+    return val ? *val : Val();
+  }
+
+  /**
+   * \returns 1 if there is an entry for id \p k, 0 otherwise.
+   */
+  std::size_t count (const index_t & k) const
+  { return this->lookup(k) ? 1 : 0; }
+
+  /**
+   * \returns The number of entries.
+   */
+  std::size_t size () const { return _size; }
+
+  bool empty () const { return !_size; }
+
+  /**
+   * Removes all entries.
+   */
+  void clear ()
+  {
+    for (std::size_t p = 0; p != _pages.size(); ++p)
+      delete _pages[p];
+    _pages.clear();
+    _size = 0;
+  }
+
+  class veclike_iterator;
+  class const_veclike_iterator;
+
+  /**
+   * Removes the entry for id \p k, if any.
+   */
+  void erase (index_t k)
+  {
+    const std::size_t p = page_of(k);
+    if (p >= _pages.size() || !_pages[p])
+      return;
+
+    Page & page = *_pages[p];
+    const unsigned int slot = slot_of(k);
+    const uint64_t bit = uint64_t(1) << (slot % 64);
+    if (!(page.present[slot / 64] & bit))
+      return;
+
+    page.values.erase(page.values.begin() + rank(page, slot));
+    page.present[slot / 64] &= ~bit;
+    --_size;
+
+    // Free pages as soon as they are empty, so iteration never has
+    // to visit them.
+    if (page.values.empty())
+      {
+        delete _pages[p];
+        _pages[p] = libmesh_nullptr;
+
+        while (!_pages.empty() && !_pages.back())
+          _pages.pop_back();
+      }
+  }
+
+  void erase (const veclike_iterator & pos)
+  { this->erase(pos.key()); }
+
+  /**
+   * Iterator over the values, in increasing id order.
+   */
+  class veclike_iterator
+  {
+  public:
+    veclike_iterator (paged_mapvector<Val, index_t> * c, index_t k)
+      : _container(c), _key(k) {}
+
+    Val & operator*() const { return *_container->lookup(_key); }
+
+    /**
+     * \returns The id of the entry we point to.
+     */
+    index_t key () const { return _key; }
+
+    veclike_iterator & operator++() { _key = _container->next_key(_key); return *this; }
+
+    veclike_iterator operator++(int) {
+      veclike_iterator i = *this;
+      ++(*this);
+      return i;
+    }
+
+    veclike_iterator & operator--() { _key = _container->prev_key(_key); return *this; }
+
+    bool operator==(const veclike_iterator & other) const {
+      return _key == other._key && _container == other._container;
+    }
+
+    bool operator!=(const veclike_iterator & other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class const_veclike_iterator;
+
+    paged_mapvector<Val, index_t> * _container;
+    index_t _key;
+  };
+
+  /**
+   * Const iterator over the values, in increasing id order.
+   */
+  class const_veclike_iterator
+  {
+  public:
+    const_veclike_iterator (const paged_mapvector<Val, index_t> * c, index_t k)
+      : _container(c), _key(k) {}
+
+    const_veclike_iterator (const veclike_iterator & i)
+      : _container(i._container), _key(i._key) {}
+
+    const Val & operator*() const { return *_container->lookup(_key); }
+
+    /**
+     * \returns The id of the entry we point to.
+     */
+    index_t key () const { return _key; }
+
+    const_veclike_iterator & operator++() { _key = _container->next_key(_key); return *this; }
+
+    const_veclike_iterator operator++(int) {
+      const_veclike_iterator i = *this;
+      ++(*this);
+      return i;
+    }
+
+    const_veclike_iterator & operator--() { _key = _container->prev_key(_key); return *this; }
+
+    bool operator==(const const_veclike_iterator & other) const {
+      return _key == other._key && _container == other._container;
+    }
+
+    bool operator!=(const const_veclike_iterator & other) const {
+      return !(*this == other);
+    }
+
+  private:
+    const paged_mapvector<Val, index_t> * _container;
+    index_t _key;
+  };
+
+  veclike_iterator begin() {
+    return veclike_iterator(this, this->first_key_from(0));
+  }
+
+  const_veclike_iterator begin() const {
+    return const_veclike_iterator(this, this->first_key_from(0));
+  }
+
+  veclike_iterator end() {
+    return veclike_iterator(this, end_key);
+  }
+
+  const_veclike_iterator end() const {
+    return const_veclike_iterator(this, end_key);
+  }
+
+  /**
+   * \returns An iterator to the entry for id \p k, or end() if there
+   * is none.
+   */
+  veclike_iterator find (const index_t & k) {
+    return veclike_iterator(this, this->lookup(k) ? k : end_key);
+  }
+
+  const_veclike_iterator find (const index_t & k) const {
+    return const_veclike_iterator(this, this->lookup(k) ? k : end_key);
+  }
+
+private:
+
+  static std::size_t page_of (index_t k)
+  { return static_cast<std::size_t>(k >> page_bits); }
+
+  static unsigned int slot_of (index_t k)
+  { return static_cast<unsigned int>(k & (page_size - 1)); }
+
+  static index_t key_of (std::size_t p, unsigned int slot)
+  { return static_cast<index_t>((static_cast<index_t>(p) << page_bits) + slot); }
+
+  /**
+   * Counts the set bits in \p x.  The builtin is only used where it
+   * maps to a single instruction; otherwise it becomes a library call
+   * that is slower than the bit-twiddling version.
+   */
+  static unsigned int popcount (uint64_t x)
+  {
+#if defined(__GNUC__) && defined(__POPCNT__)
+    return static_cast<unsigned int>(__builtin_popcountll(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<unsigned int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+  }
+
+  /**
+   * Counts the trailing zero bits in nonzero \p x.
+   */
+  static unsigned int trailing_zeros (uint64_t x)
+  {
+#ifdef __GNUC__
+    return static_cast<unsigned int>(__builtin_ctzll(x));
+#else
+    return popcount((x & (~x + 1)) - 1);
+#endif
+  }
+
+  /**
+   * \returns The position in \p page.values of the value for \p slot,
+   * i.e. the number of present slots before it.
+   */
+  static std::size_t rank (const Page & page, unsigned int slot)
+  {
+    std::size_t r = 0;
+    const unsigned int word = slot / 64;
+    for (unsigned int w = 0; w != word; ++w)
+      r += popcount(page.present[w]);
+    const unsigned int bit = slot % 64;
+    if (bit)
+      r += popcount(page.present[word] & ((uint64_t(1) << bit) - 1));
+    return r;
+  }
+
+  const Val * lookup (index_t k) const
+  {
+    const std::size_t p = page_of(k);
+    if (p >= _pages.size() || !_pages[p])
+      return libmesh_nullptr;
+
+    const Page & page = *_pages[p];
+    const unsigned int slot = slot_of(k);
+    if (!(page.present[slot / 64] & (uint64_t(1) << (slot % 64))))
+      return libmesh_nullptr;
+
+    return &page.values[rank(page, slot)];
+  }
+
+  Val * lookup (index_t k)
+  {
+    return const_cast<Val *>
+      (static_cast<const paged_mapvector<Val, index_t> &>(*this).lookup(k));
+  }
+
+  Val & insert_default (index_t k)
+  {
+    libmesh_assert_not_equal_to (k, end_key);
+
+    const std::size_t p = page_of(k);
+    if (p >= _pages.size())
+      _pages.resize(p+1, libmesh_nullptr);
+    if (!_pages[p])
+      _pages[p] = new Page;
+
+    Page & page = *_pages[p];
+    const unsigned int slot = slot_of(k);
+    const std::size_t r = rank(page, slot);
+    page.values.insert(page.values.begin() + r, Val());
+    page.present[slot / 64] |= (uint64_t(1) << (slot % 64));
+    ++_size;
+
+    return page.values[r];
+  }
+
+  /**
+   * \returns The smallest present id which is at least \p k, or
+   * end_key if there is none.
+   */
+  index_t first_key_from (index_t k) const
+  {
+    std::size_t p = page_of(k);
+    unsigned int slot = slot_of(k);
+
+    for (; p < _pages.size(); ++p, slot = 0)
+      {
+        const Page * page = _pages[p];
+        if (!page)
+          continue;
+
+        for (unsigned int w = slot / 64; w != words_per_page; ++w)
+          {
+            uint64_t bits = page->present[w];
+            if (w == slot / 64)
+              bits &= ~((uint64_t(1) << (slot % 64)) - 1);
+            if (bits)
+              return key_of(p, w*64 + trailing_zeros(bits));
+          }
+      }
+
+    return end_key;
+  }
+
+  index_t next_key (index_t k) const
+  {
+    libmesh_assert_not_equal_to (k, end_key);
+    return (k + 1 == end_key) ? end_key : this->first_key_from(k + 1);
+  }
+
+  /**
+   * \returns The largest present id which is less than \p k (or the
+   * largest present id, if \p k is end_key).
+   */
+  index_t prev_key (index_t k) const
+  {
+    std::size_t p;
+    int slot;
+    if (k == end_key)
+      {
+        p = _pages.size();
+        slot = page_size - 1;
+      }
+    else
+      {
+        p = page_of(k) + 1;
+        slot = static_cast<int>(slot_of(k)) - 1;
+      }
+
+    for (; p != 0; --p, slot = page_size - 1)
+      {
+        const Page * page = _pages[p-1];
+        if (!page || slot < 0)
+          continue;
+
+        for (int s = slot; s >= 0; --s)
+          if (page->present[s / 64] & (uint64_t(1) << (s % 64)))
+            return key_of(p-1, s);
+      }
+
+    libmesh_error_msg("Decremented paged_mapvector iterator past begin()");
+    return end_key;
+  }
+
+  std::vector<Page *> _pages;
+
+  std::size_t _size;
+};
+
+template <typename Val, typename index_t>
+const unsigned int paged_mapvector<Val, index_t>::page_bits;
+
+template <typename Val, typename index_t>
+const index_t paged_mapvector<Val, index_t>::page_size;
+
+template <typename Val, typename index_t>
+const index_t paged_mapvector<Val, index_t>::end_key;
+
+} // namespace libMesh
+
+#endif // LIBMESH_PAGED_MAPVECTOR_H
@@ -28,6 +28,7 @@
 
 // C++ includes
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace libMesh
@@ -107,6 +108,20 @@ public:
                            std::set<const Elem *> & candidate_elements,
                            const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr) const = 0;
 
+  /**
+   * Locates the elements containing each of \p points, storing them
+   * in the corresponding entries of \p elems.  Points which are in
+   * no element are handled as by \p operator(), i.e. they give NULL
+   * entries in out-of-mesh mode.  Optionally allows the user to
+   * restrict the subdomains searched.
+   *
+   * The base class simply calls \p operator() for each point;
+   * subclasses can override this for efficiency with large batches.
+   */
+  virtual void locate_elements (const std::vector<Point> & points,
+                                std::vector<const Elem *> & elems,
+                                const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr) const;
+
   /**
    * \returns A pointer to a Node with global coordinates \p p or \p
    * NULL if no such Node can be found.
@@ -167,6 +182,15 @@ public:
   bool _verbose;
 
 protected:
+  /**
+   * \returns A Morton (Z-order) key for the point \p p, which should
+   * lie in the box with corners \p pmin and \p pmax.  Sorting points
+   * by their keys groups nearby points together.
+   */
+  static uint64_t morton_key (const Point & p,
+                              const Point & pmin,
+                              const Point & pmax);
+
   /**
    * Const pointer to our master, initialized to \p NULL if none
    * given.  When using multiple PointLocators, one can be assigned
@@ -0,0 +1,187 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2017 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_POINT_LOCATOR_BVH_H
+#define LIBMESH_POINT_LOCATOR_BVH_H
+
+// Local Includes
+#include "libmesh/point_locator_base.h"
+
+// C++ includes
+#include <cstddef>
+#include <memory>
+
+namespace libMesh
+{
+
+// Forward Declarations
+class MeshBase;
+class Point;
+class Elem;
+
+/**
+ * This is a point locator backed by a bounding volume hierarchy
+ * (BVH) over the bounding boxes of the active elements.  The
+ * elements are sorted along a Morton curve through their box centers,
+ * and the hierarchy is built by recursively halving that ordering,
+ * so each element is stored exactly once and the tree is balanced
+ * regardless of element shape.  This keeps memory use linear in the
+ * number of elements even on strongly anisotropic meshes, where the
+ * bins of a \p PointLocatorTree can each hold many long thin
+ * elements.
+ *
+ * The boxes of first order and affinely mapped elements are known
+ * to bound them.  As with the bins of \p PointLocatorTree, curved
+ * higher order elements are only found near the bounding boxes of
+ * their nodes; we enlarge those boxes by a quarter of the element
+ * size to allow for curved sides.  Since that is only a guess, a
+ * search which finds nothing in the hierarchy goes on to check every
+ * curved element, so locating points outside a curved mesh costs
+ * time linear in the number of curved elements.
+ *
+ * Use \p PointLocatorBase::build() with \p BVH to create objects of
+ * this type at run time.
+ */
+class PointLocatorBVH : public PointLocatorBase
+{
+public:
+  /**
+   * Constructor.  Needs the \p mesh in which the points should be
+   * located.  Optionally takes a master locator, whose hierarchy is
+   * then shared rather than built again.
+   */
+  PointLocatorBVH (const MeshBase & mesh,
+                   const PointLocatorBase * master = libmesh_nullptr);
+
+  /**
+   * Destructor.
+   */
+  ~PointLocatorBVH ();
+
+  /**
+   * Clears the locator.
+   */
+  virtual void clear() libmesh_override;
+
+  /**
+   * Initializes the locator, so that the \p operator() methods can
+   * be used.  Element bounding boxes are computed in parallel on
+   * multiple threads.
+   */
+  virtual void init() libmesh_override;
+
+  /**
+   * Locates the element in which the point with global coordinates
+   * \p p is located, optionally restricted to a set of allowed
+   * subdomains.  As in \p PointLocatorTree, the result is cached and
+   * checked first during the next call.
+   */
+  virtual const Elem * operator() (const Point & p,
+                                   const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr) const libmesh_override;
+
+  /**
+   * Locates the elements which are close to the point with global
+   * coordinates \p p, to within the close-to-point tolerance,
+   * optionally restricted to a set of allowed subdomains.
+   */
+  virtual void operator() (const Point & p,
+                           std::set<const Elem *> & candidate_elements,
+                           const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr) const libmesh_override;
+
+  /**
+   * Enables out-of-mesh mode.  In this mode, if asked to find a point
+   * that is contained in no mesh at all, the point locator will
+   * return a NULL pointer instead of crashing.  Per default, this
+   * mode is off.
+   */
+  virtual void enable_out_of_mesh_mode () libmesh_override;
+
+  /**
+   * Disables out-of-mesh mode (default).  If asked to find a point
+   * that is contained in no mesh at all, the point locator will now
+   * crash.
+   */
+  virtual void disable_out_of_mesh_mode () libmesh_override;
+
+  /**
+   * Set the maximum number of elements in a leaf of the hierarchy.
+   * Takes effect on the next \p init().
+   */
+  void set_leaf_size(unsigned int leaf_size);
+
+  /**
+   * Get the maximum number of elements in a leaf of the hierarchy.
+   */
+  unsigned int get_leaf_size() const;
+
+  /**
+   * \returns The number of nodes in the hierarchy.
+   */
+  std::size_t n_bvh_nodes() const;
+
+  /**
+   * \returns The number of bytes allocated for the hierarchy.
+   */
+  std::size_t memory_usage() const;
+
+private:
+  /**
+   * The hierarchy itself, which is defined in the implementation
+   * file.
+   */
+  struct Hierarchy;
+
+  /**
+   * \returns The first allowed element in the hierarchy for which \p
+   * close_to_point(p, tol) holds if \p close is \p true, or which
+   * contains \p p otherwise.  If \p candidates is given, all such
+   * elements are inserted into it instead.
+   */
+  const Elem * search (const Point & p,
+                       const std::set<subdomain_id_type> * allowed_subdomains,
+                       bool close,
+                       Real tol,
+                       std::set<const Elem *> * candidates) const;
+
+  /**
+   * Our hierarchy.  Servant locators share their master's.
+   */
+  std::shared_ptr<const Hierarchy> _bvh;
+
+  /**
+   * Pointer to the last element that was found.  Chances are that
+   * this may be close to the next call to \p operator()...
+   */
+  mutable const Elem * _element;
+
+  /**
+   * \p true if out-of-mesh mode is enabled.  See \p
+   * enable_out_of_mesh_mode() for details.
+   */
+  bool _out_of_mesh_mode;
+
+  /**
+   * Maximum number of elements per leaf.
+   */
+  unsigned int _leaf_size;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_POINT_LOCATOR_BVH_H
@@ -115,6 +115,21 @@ public:
                            std::set<const Elem *> & candidate_elements,
                            const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr) const libmesh_override;
 
+  /**
+   * Locates the elements containing each of \p points.  The points
+   * are sorted along a space-filling curve and cut into batches of
+   * spatially nearby points, and each batch is passed down the tree
+   * together.  Batches are searched in parallel on multiple threads.
+   * Points which the tree cannot find are then handled as in \p
+   * operator(), with the close-to-point linear search if a tolerance
+   * has been set.
+   * Unlike \p operator(), this does not use or update the cached
+   * element from previous searches.
+   */
+  virtual void locate_elements (const std::vector<Point> & points,
+                                std::vector<const Elem *> & elems,
+                                const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr) const libmesh_override;
+
   /**
    * As a fallback option, it's helpful to be able to do a linear
    * search over the entire mesh. This can be used if operator()
@@ -23,9 +23,9 @@
 // Local Includes
 #include "libmesh/libmesh_config.h"
 #include "libmesh/libmesh_common.h"
+#include "libmesh/concurrent_hash_map.h"
 
 // C++ Includes
-#include <unordered_map>
 #include <functional> // std::hash
 #include <vector>
 
@@ -59,8 +59,9 @@ public:
  * A node created in the middle of a cell's quad face will be the
  * value of two keys, one for each node pair bracketing it.
  *
- * For efficiency we will use a hashed map if it is available,
- * otherwise a regular map.
+ * The map is a concurrent_hash_map, so add_node() and find() may be
+ * called from several threads at once, and init() fills it on all
+ * threads.
  *
  * \author Roy Stogner
  * \date 2015
@@ -69,7 +70,7 @@ public:
 class TopologyMap
 {
   // We need to supply our own hash function.
-  typedef std::unordered_map<std::pair<dof_id_type, dof_id_type>, dof_id_type, myhash> map_type;
+  typedef concurrent_hash_map<std::pair<dof_id_type, dof_id_type>, dof_id_type, myhash> map_type;
 public:
   void init(MeshBase &);
 
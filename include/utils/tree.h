@@ -86,6 +86,14 @@ public:
                                     const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr,
                                     Real relative_tol = TOLERANCE) const libmesh_override;
 
+  /**
+   * Locates the elements containing each of \p points.
+   */
+  virtual void find_elements(const std::vector<Point> & points,
+                             std::vector<const Elem *> & elems,
+                             const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr,
+                             Real relative_tol = TOLERANCE) const libmesh_override;
+
   /**
    * \returns A pointer to the element containing point p,
    * optionally restricted to a set of allowed subdomains,
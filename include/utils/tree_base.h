@@ -25,6 +25,7 @@
 
 // C++ includes
 #include <set>
+#include <vector>
 
 namespace libMesh
 {
@@ -101,6 +102,21 @@ public:
                                     const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr,
                                     Real relative_tol = TOLERANCE) const = 0;
 
+  /**
+   * Fills \p elems with pointers to the elements containing each of
+   * \p points, or NULL for points which are contained in no element,
+   * optionally restricted to a set of allowed subdomains,
+   * optionally using a non-zero relative tolerance for searches.
+   * This is equivalent to calling \p find_element() for each point
+   * (up to the choice between elements which all contain a point),
+   * but descends the tree once for the whole batch, so spatially
+   * coherent batches are cheaper to locate.
+   */
+  virtual void find_elements(const std::vector<Point> & points,
+                             std::vector<const Elem *> & elems,
+                             const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr,
+                             Real relative_tol = TOLERANCE) const = 0;
+
 protected:
 
   /**
@@ -155,8 +155,55 @@ public:
                              const std::set<subdomain_id_type> * allowed_subdomains = libmesh_nullptr,
                              Real relative_tol = TOLERANCE) const;
 
+  /**
+   * Locates the elements containing the points \p points[q] for each
+   * \p q in \p queries, storing them in \p elems[q].  The queries
+   * are passed down the tree together, so each TreeNode is visited
+   * at most once per batch.  Entries whose points are not found in
+   * the bins bounding them are left untouched; unlike \p
+   * find_element(), the remaining bins are not searched.
+   */
+  void find_elements (const std::vector<Point> & points,
+                      const std::vector<unsigned int> & queries,
+                      std::vector<const Elem *> & elems,
+                      const std::set<subdomain_id_type> * allowed_subdomains,
+                      Real relative_tol) const;
+
+  /**
+   * Caches bounding boxes of the elements in active TreeNodes, which
+   * are then used to skip the inverse map for elements which cannot
+   * contain the point, while searching the bins which bound it.  The
+   * exhaustive search \p find_element() falls back on doesn't use
+   * them, so elements whose nodes have moved since are still found.
+   */
+  void cache_element_boxes ();
+
 
 private:
+  /**
+   * Looks for point \p p in the active TreeNodes which bound it,
+   * skipping elements whose cached bounding boxes exclude it.
+   */
+  const Elem * find_element_in_bins (const Point & p,
+                                     const std::set<subdomain_id_type> * allowed_subdomains,
+                                     Real relative_tol) const;
+
+  /**
+   * Looks for point \p p in the TreeNodes which bound it, then in
+   * every other TreeNode, without using the cached bounding boxes.
+   */
+  const Elem * find_element_exhaustive (const Point & p,
+                                        const std::set<subdomain_id_type> * allowed_subdomains,
+                                        Real relative_tol) const;
+
+  /**
+   * \returns \p false if the cached bounding box of element \p e
+   * of this active node excludes \p p, \p true otherwise.
+   */
+  bool element_may_contain (std::size_t e,
+                            const Point & p,
+                            Real relative_tol) const;
+
   /**
    * Look for point \p p in our children,
    * optionally restricted to a set of allowed subdomains.
@@ -196,6 +243,12 @@ private:
    */
   std::vector<const Elem *> elements;
 
+  /**
+   * Bounding boxes of the entries in \p elements, slightly enlarged,
+   * or empty if they have not been cached.
+   */
+  std::vector<BoundingBox> element_boxes;
+
   /**
    * The node numbers contained in this portion of the tree.
    */
@@ -220,11 +273,6 @@ private:
    * Does this node contain any infinite elements.
    */
   bool contains_ifems;
-
-  /**
-   * Used in find_element_in_children
-   */
-  mutable std::vector<bool> searched_child;
 };
 
 
@@ -35,8 +35,11 @@
 #  endif
 #endif
 
+#include <cstdint>
 #include <cstdio> // FILE
+#include <cstring>
 #include <iosfwd>
+#include <type_traits>
 #include <vector>
 #include <string>
 #ifdef LIBMESH_USE_COMPLEX_NUMBERS
@@ -54,6 +57,13 @@ const unsigned int xdr_MAX_STRING_LENGTH=256;
 namespace libMesh
 {
 
+// Forward declarations
+class BackgroundWriter;
+namespace Parallel
+{
+class Communicator;
+}
+
 /**
  * This class implements a C++ interface to the XDR
  * (eXternal Data Representation) format.  XDR is useful for
@@ -155,6 +165,112 @@ public:
    */
   void comment (std::string &);
 
+  /**
+   * By default, files opened for DECODE are memory-mapped where the
+   * system allows it, so that \p data_stream() and callers of \p
+   * mapped_data() can decode them in place, on multiple threads.
+   * Passing \p false before calling \p open() reads them through
+   * stdio instead.
+   */
+  void set_memory_mapping (bool use_mmap) { memory_mapping = use_mmap; }
+
+  /**
+   * Files opened for ENCODE or WRITE after this is called with a
+   * non-null \p writer are buffered in memory, and handed to \p
+   * writer to be written (and compressed, if their name says so) on
+   * a background thread once they are closed.  Binary files are only
+   * buffered where the system has open_memstream().
+   */
+  void set_background_writer (BackgroundWriter * writer) { background_writer = writer; }
+
+  /**
+   * Writes \p contents, the complete contents of a file written with
+   * mode \p m, to file \p name, compressing ASCII files as their
+   * name says.  This is how \p BackgroundWriter writes buffered
+   * files.
+   */
+  static void write_file (const std::string & name,
+                          const XdrMODE m,
+                          const std::string & contents);
+
+  /**
+   * \returns A pointer to the next unread byte of a file being
+   * decoded from memory-mapped pages, or \p libmesh_nullptr if the
+   * file is not mapped.  Up to \p mapped_bytes_left() bytes from there
+   * may be read in place with \p decode(), and then passed over with
+   * \p skip_mapped().
+   */
+  const char * mapped_data () const;
+
+  /**
+   * \returns The number of bytes left after \p mapped_data().
+   */
+  std::size_t mapped_bytes_left () const;
+
+  /**
+   * Moves past \p n_bytes bytes of a memory-mapped file, which
+   * have been decoded in place.
+   */
+  void skip_mapped (std::size_t n_bytes);
+
+  /**
+   * \returns The number of bytes XDR uses to encode a \p T; anything
+   * smaller than four bytes is padded, and long double is encoded as
+   * double.
+   */
+  template <typename T>
+  static std::size_t encoded_size () { return (sizeof(T) <= 4) ? 4 : 8; }
+
+  /**
+   * \returns The \p T encoded, big-endian, in the \p encoded_size<T>()
+   * bytes at \p bytes.
+   */
+  template <typename T>
+  static T decode (const char * bytes);
+
+  /**
+   * Encodes \p value, big-endian, into the \p encoded_size<T>() bytes
+   * at \p bytes.
+   */
+  template <typename T>
+  static void encode (const T value, char * bytes);
+
+  /**
+   * \returns \p true if \p write_collective() or \p
+   * read_collective() may be used with this file, which requires a
+   * binary file and MPI.
+   */
+  bool collective_io () const;
+
+  /**
+   * Collectively writes values from every processor of \p comm into
+   * a binary file, which only processor 0 needs to have open, at the
+   * point processor 0 has reached; then moves processor 0 past them.
+   * This processor's values \p vals come in runs, the i'th of which
+   * is \p lengths[i] values long and starts \p offsets[i] values
+   * into the \p n_total values being written by all processors.  The
+   * offsets must increase.  Each processor writes its own runs with
+   * MPI-IO, so no processor ever holds more than its own values.
+   */
+  template <typename T>
+  void write_collective (const Parallel::Communicator & comm,
+                         const std::vector<T> & vals,
+                         const std::vector<std::size_t> & offsets,
+                         const std::vector<std::size_t> & lengths,
+                         const std::size_t n_total);
+
+  /**
+   * The reverse of \p write_collective(): collectively reads each
+   * processor's runs of values into \p vals, and moves processor 0
+   * past all \p n_total values.
+   */
+  template <typename T>
+  void read_collective (const Parallel::Communicator & comm,
+                        std::vector<T> & vals,
+                        const std::vector<std::size_t> & offsets,
+                        const std::vector<std::size_t> & lengths,
+                        const std::size_t n_total);
+
   /**
    * Sets the version of the file that is being read
    */
@@ -197,6 +313,34 @@ private:
   template <typename T>
   void do_write(std::vector<std::complex<T>> & a);
 
+  /**
+   * Decodes \p len values from a memory-mapped file directly into \p
+   * val, on multiple threads for long streams.  \returns \p false if
+   * the file is not mapped.
+   */
+  template <typename T>
+  bool decode_mapped(T * val, const unsigned int len);
+
+  /**
+   * Helper for \p decode(): interprets encoded \p bits as a \p T.
+   */
+  template <typename T, typename U>
+  static T from_bits (U bits);
+
+  /**
+   * Helper for \p write_collective() and \p read_collective(): opens
+   * the file on every processor of \p comm, sets the view of each to
+   * its runs of \p value_size byte values, and does the collective
+   * transfer of \p buffer, and then moves processor 0 past all \p
+   * n_total values.
+   */
+  void transfer_collective (const Parallel::Communicator & comm,
+                            std::vector<char> & buffer,
+                            std::size_t value_size,
+                            const std::vector<std::size_t> & offsets,
+                            const std::vector<std::size_t> & lengths,
+                            const std::size_t n_total);
+
   /**
    * The mode used for accessing the file.
    */
@@ -220,8 +364,36 @@ private:
    */
   FILE * fp;
 
+  /**
+   * The memory-mapped file being decoded, if any, and its size.
+   */
+  char * mapped_file;
+  std::size_t mapped_size;
+
+  /**
+   * The memory a buffered binary file is being written into, and its
+   * size.
+   */
+  char * buffer_data;
+  std::size_t buffer_size;
+
 #endif
 
+  /**
+   * Should files opened for DECODE be memory-mapped?
+   */
+  bool memory_mapping;
+
+  /**
+   * Where buffered files are handed to be written, if anywhere.
+   */
+  BackgroundWriter * background_writer;
+
+  /**
+   * Is the open file being buffered in memory?
+   */
+  bool buffered;
+
   /**
    * The input file stream.
    */
@@ -243,6 +415,13 @@ private:
    */
   bool gzipped_file, bzipped_file, xzipped_file;
 
+  /**
+   * Should compressing the file with a command line tool on close()
+   * be logged?  Not by write_file(), which runs on the threads of a
+   * BackgroundWriter.
+   */
+  bool log_compression;
+
   /**
    * Version of the file being read
    */
@@ -250,6 +429,83 @@ private:
 };
 
 
+
+// ------------------------------------------------------------
+// Xdr inline members
+template <typename T>
+inline
+T Xdr::decode (const char * bytes)
+{
+  const unsigned char * b = reinterpret_cast<const unsigned char *>(bytes);
+
+  if (encoded_size<T>() == 4)
+    return from_bits<T>(uint32_t(b[0]) << 24 | uint32_t(b[1]) << 16 |
+                        uint32_t(b[2]) << 8  | uint32_t(b[3]));
+
+  uint64_t bits = 0;
+  for (unsigned int i=0; i != 8; ++i)
+    bits = bits << 8 | b[i];
+  return from_bits<T>(bits);
+}
+
+
+
+template <typename T>
+inline
+void Xdr::encode (const T value, char * bytes)
+{
+  unsigned char * b = reinterpret_cast<unsigned char *>(bytes);
+
+  if (encoded_size<T>() == 4)
+    {
+      uint32_t bits;
+      if (std::is_floating_point<T>::value)
+        {
+          const float f = static_cast<float>(value);
+          std::memcpy(&bits, &f, 4);
+        }
+      else
+        bits = static_cast<uint32_t>(value);
+
+      for (unsigned int i=0; i != 4; ++i)
+        b[i] = static_cast<unsigned char>(bits >> (24 - 8*i));
+      return;
+    }
+
+  uint64_t bits;
+  if (std::is_floating_point<T>::value)
+    {
+      const double d = static_cast<double>(value);
+      std::memcpy(&bits, &d, 8);
+    }
+  else
+    bits = static_cast<uint64_t>(value);
+
+  for (unsigned int i=0; i != 8; ++i)
+    b[i] = static_cast<unsigned char>(bits >> (56 - 8*i));
+}
+
+
+
+template <typename T, typename U>
+inline
+T Xdr::from_bits (U bits)
+{
+  if (std::is_floating_point<T>::value)
+    {
+      typedef typename std::conditional<sizeof(U) == 4, float, double>::type F;
+      F f;
+      std::memcpy(&f, &bits, sizeof(F));
+      return static_cast<T>(f);
+    }
+
+  if (std::is_signed<T>::value)
+    return static_cast<T>(static_cast<typename std::make_signed<U>::type>(bits));
+
+  return static_cast<T>(bits);
+}
+
+
 } // namespace libMesh
 
 
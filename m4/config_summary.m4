@@ -183,6 +183,7 @@ if (test "x$enableoptional" = "xyes"); then
   if (test "x$enablevtk" = "xyes"); then
   echo '     'version....................... : $vtkversion
   fi
+  echo '  'zstd............................. : $enablezstd
   echo
   if (test "x$libmesh_optional_INCLUDES" != "x"); then
   echo '  'libmesh_optional_INCLUDES........ : $libmesh_optional_INCLUDES
@@ -96,6 +96,29 @@ fi
 
 
 
+# --------------------------------------------------------------
+# mmap() - used to decode binary Xdr files in place
+# --------------------------------------------------------------
+AC_CHECK_HEADERS(sys/mman.h, [have_sys_mman_h=yes], [have_sys_mman_h=no])
+if test "$have_sys_mman_h" = yes ; then
+  AC_CHECK_FUNC(mmap,
+                [AC_DEFINE(HAVE_MMAP, 1,
+                           [Flag indicating if the library may memory-map files with mmap()])])
+fi
+# --------------------------------------------------------------
+
+
+
+# --------------------------------------------------------------
+# open_memstream() - used to buffer binary Xdr files in memory
+# --------------------------------------------------------------
+AC_CHECK_FUNC(open_memstream,
+              [AC_DEFINE(HAVE_OPEN_MEMSTREAM, 1,
+                         [Flag indicating if the library may buffer files in memory with open_memstream()])])
+# --------------------------------------------------------------
+
+
+
 # --------------------------------------------------------------
 # C++ exceptions - enabled by default
 # --------------------------------------------------------------
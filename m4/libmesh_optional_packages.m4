@@ -259,6 +259,16 @@ if (test "$enablebz2" != no) ; then
                    [Flag indicating bzip2/bunzip2 are available for handling compressed .bz2 files])
        fi
    fi
+
+   # With libbz2 we can stream .bz2 files in-process instead
+   AC_CHECK_HEADERS(bzlib.h, have_bzlib_h=yes)
+   AC_CHECK_LIB(bz2, BZ2_bzCompressInit, have_libbz2=yes)
+   if (test "$have_bzlib_h" = yes -a "$have_libbz2" = yes) ; then
+     AC_MSG_RESULT(<<< Using libbz2 for streaming compressed .bz2 files >>>)
+     AC_DEFINE(HAVE_BZLIB, 1,
+               [Flag indicating libbz2 is available for streaming compressed .bz2 files])
+     libmesh_optional_LIBS="-lbz2 $libmesh_optional_LIBS"
+   fi
 fi
 # -------------------------------------------------------------
 
@@ -280,6 +290,40 @@ if (test "$enablexz" != no) ; then
       AC_DEFINE(HAVE_XZ, 1,
                 [Flag indicating xz is available for handling compressed .xz files])
    fi
+
+   # With liblzma we can stream .xz files in-process instead
+   AC_CHECK_HEADERS(lzma.h, have_lzma_h=yes)
+   AC_CHECK_LIB(lzma, lzma_stream_encoder_mt, have_liblzma=yes)
+   if (test "$have_lzma_h" = yes -a "$have_liblzma" = yes) ; then
+     AC_MSG_RESULT(<<< Using liblzma for streaming compressed .xz files >>>)
+     AC_DEFINE(HAVE_LZMA, 1,
+               [Flag indicating liblzma is available for streaming compressed .xz files])
+     libmesh_optional_LIBS="-llzma $libmesh_optional_LIBS"
+   fi
+fi
+# -------------------------------------------------------------
+
+
+# -------------------------------------------------------------
+# Compressed Files with zstd
+# -------------------------------------------------------------
+AC_ARG_ENABLE(zstd,
+              AS_HELP_STRING([--disable-zstd],
+                             [build without zstd compressed I/O support]),
+              enablezstd=$enableval,
+              enablezstd=$enableoptional)
+
+if (test "$enablezstd" != no) ; then
+   AC_CHECK_HEADERS(zstd.h, have_zstd_h=yes)
+   AC_CHECK_LIB(zstd, ZSTD_compressStream2, have_libzstd=yes)
+   if (test "$have_zstd_h" = yes -a "$have_libzstd" = yes) ; then
+     AC_MSG_RESULT(<<< Using libzstd for streaming compressed .zst files >>>)
+     AC_DEFINE(HAVE_ZSTD, 1,
+               [Flag indicating libzstd is available for streaming compressed .zst files])
+     libmesh_optional_LIBS="-lzstd $libmesh_optional_LIBS"
+   else
+     enablezstd=no
+   fi
 fi
 # -------------------------------------------------------------
 
@@ -14,7 +14,8 @@
   CPPUNIT_TEST( testSetNSystems );              \
   CPPUNIT_TEST( testSetNVariableGroups );       \
   CPPUNIT_TEST( testManualDofCalculation );     \
-  CPPUNIT_TEST( testJensEftangBug );
+  CPPUNIT_TEST( testJensEftangBug );            \
+  CPPUNIT_TEST( testIndexArena );
 
 using namespace libMesh;
 
@@ -185,6 +186,43 @@ public:
     CPPUNIT_ASSERT_EQUAL (aobject.dof_number(0,2,0), static_cast<dof_id_type>(193));
     CPPUNIT_ASSERT_EQUAL (aobject.dof_number(1,0,0), static_cast<dof_id_type>(  1));
   }
+
+  void testIndexArena()
+  {
+    DofObject aobject(*instance);
+    dof_id_type buf0[] = {2, 8, 257, 0, 257, 96, 257, 192, 257, 0};
+    aobject.set_buffer(std::vector<dof_id_type>(buf0, buf0+10));
+
+    CPPUNIT_ASSERT_EQUAL (aobject.index_buffer_size(), 10u);
+
+    std::vector<dof_id_type> arena(12, DofObject::invalid_id);
+    aobject.use_index_arena(&arena[1]);
+
+    // The indexing now lives in the arena
+    CPPUNIT_ASSERT_EQUAL (arena[0], DofObject::invalid_id);
+    CPPUNIT_ASSERT_EQUAL (arena[11], DofObject::invalid_id);
+    for (unsigned int i=0; i != 10; ++i)
+      CPPUNIT_ASSERT_EQUAL (arena[i+1], buf0[i]);
+
+    CPPUNIT_ASSERT_EQUAL (aobject.dof_number(0,1,0), static_cast<dof_id_type>( 96));
+    CPPUNIT_ASSERT_EQUAL (aobject.dof_number(1,0,0), static_cast<dof_id_type>(  0));
+
+    // Writing dof numbers writes through to the arena
+    aobject.set_vg_dof_base(1, 0, 3);
+    CPPUNIT_ASSERT_EQUAL (arena[10], static_cast<dof_id_type>(3));
+
+    // Changing the layout moves the indexing back out, leaving the
+    // arena untouched
+    aobject.add_system();
+    CPPUNIT_ASSERT_EQUAL (aobject.n_systems(), 3u);
+    CPPUNIT_ASSERT_EQUAL (aobject.dof_number(0,2,0), static_cast<dof_id_type>(192));
+    CPPUNIT_ASSERT_EQUAL (aobject.dof_number(1,0,0), static_cast<dof_id_type>(  3));
+    CPPUNIT_ASSERT_EQUAL (arena[1], static_cast<dof_id_type>(2));
+
+    // Copies never share the arena
+    DofObject copy(aobject);
+    CPPUNIT_ASSERT_EQUAL (copy.dof_number(1,0,0), static_cast<dof_id_type>(  3));
+  }
 };
 
 #endif // #ifdef __dof_object_test_h__
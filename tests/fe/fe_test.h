@@ -11,6 +11,7 @@
 #include <libmesh/mesh.h>
 #include <libmesh/mesh_generation.h>
 #include <libmesh/numeric_vector.h>
+#include <libmesh/quadrature_gauss.h>
 #include <libmesh/system.h>
 
 // Ignore unused parameter warnings coming from cppunit headers
@@ -24,7 +25,8 @@
 #define FETEST                                  \
   CPPUNIT_TEST( testU );                        \
   CPPUNIT_TEST( testGradU );                    \
-  CPPUNIT_TEST( testGradUComp );
+  CPPUNIT_TEST( testGradUComp );               \
+  CPPUNIT_TEST( testQuadrature );
 
 using namespace libMesh;
 
@@ -264,6 +266,52 @@ public:
 #endif
   }
 
+  void testQuadrature()
+  {
+    // Handle the "more processors than elements" case
+    if (!_elem)
+      return;
+
+    QGauss qrule (_dim, FIFTH);
+    _fe->attach_quadrature_rule(&qrule);
+    const std::vector<Point> & xyz = _fe->get_xyz();
+
+    // Reinit more than once, so that we also test the path where
+    // shape function values are reused rather than recomputed.
+    for (unsigned int r=0; r != 2; ++r)
+      {
+        _fe->reinit(_elem);
+
+        for (std::size_t qp = 0; qp != xyz.size(); ++qp)
+          {
+            Number u = 0;
+            Gradient grad_u = 0;
+            for (std::size_t d = 0; d != _dof_indices.size(); ++d)
+              {
+                u += _fe->get_phi()[d][qp] * (*_sys->current_local_solution)(_dof_indices[d]);
+                grad_u += _fe->get_dphi()[d][qp] * (*_sys->current_local_solution)(_dof_indices[d]);
+              }
+
+            const Real x = xyz[qp](0);
+            const Real y = (LIBMESH_DIM > 1) ? xyz[qp](1) : 0;
+            const Real z = (LIBMESH_DIM > 2) ? xyz[qp](2) : 0;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL
+              (libmesh_real(u),
+               libmesh_real(x + 0.25*y + 0.0625*z),
+               TOLERANCE*TOLERANCE);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(libmesh_real(grad_u(0)), 1.0,
+                                         TOLERANCE*sqrt(TOLERANCE));
+            if (_dim > 1)
+              CPPUNIT_ASSERT_DOUBLES_EQUAL(libmesh_real(grad_u(1)), 0.25,
+                                           TOLERANCE*sqrt(TOLERANCE));
+            if (_dim > 2)
+              CPPUNIT_ASSERT_DOUBLES_EQUAL(libmesh_real(grad_u(2)), 0.0625,
+                                           TOLERANCE*sqrt(TOLERANCE));
+          }
+      }
+  }
+
 };
 
 // THE CPPUNIT_TEST_SUITE_END macro expands to code that involves